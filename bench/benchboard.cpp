@@ -0,0 +1,24 @@
+#include <QDir>
+
+#include "benchmain.h"
+#include "model/board.h"
+
+void BenchMain::benchBoardLoad_data()
+{
+    QTest::addColumn<QString>("fileName");
+
+    QStringList maps = QDir( ":/maps" ).entryList( QStringList() << "level*.txt", QDir::Files );
+    for( const QString& name : maps ) {
+        QTest::newRow( qPrintable(name) ) << QString( ":/maps/%1" ).arg( name );
+    }
+}
+
+void BenchMain::benchBoardLoad()
+{
+    QFETCH( QString, fileName );
+
+    Board board;
+    QBENCHMARK {
+        QVERIFY( board.load( fileName, 1 ) );
+    }
+}
@@ -0,0 +1,60 @@
+#include "benchmain.h"
+#include "controller/game.h"
+#include "model/board.h"
+#include "util/mapgenerator.h"
+
+void BenchMain::benchShootThru_data()
+{
+    QTest::addColumn<QString>("map");
+
+    QTest::newRow("open 64x64")    << benchOpenMap( 64, 64 );
+    QTest::newRow("mirrors 64x64") << MapGenerator( 64, 64 ).generate( MapGenerator::MirrorField );
+    QTest::newRow("mirrors 256x256") << MapGenerator( 256, 256 ).generate( MapGenerator::MirrorField );
+}
+
+void BenchMain::benchShootThru()
+{
+    QFETCH( QString, map );
+    initGame( map );
+
+    Game& game = mRegistry.getGame();
+    Board* board = game.getBoard();
+    int width = board->getWidth();
+    int height = board->getHeight();
+
+    QBENCHMARK {
+        for( int row = 0; row < height; ++row ) {
+            for( int col = 0; col < width; ++col ) {
+                for( int angle = 0; angle < 360; angle += 90 ) {
+                    int shotAngle = angle;
+                    game.canShootThru( ModelPoint( col, row ), &shotAngle );
+                }
+            }
+        }
+    }
+}
+
+void BenchMain::benchSightCannons()
+{
+    // Cannons which line up with the tank but are blocked just short of it, so each sighting scans the full distance:
+    QString map;
+    for( int row = 0; row < 64; ++row ) {
+        QString line( 64, '.' );
+        if ( row == 0 ) {
+            line[0]  = '>';
+            line[31] = 'S';
+            line[32] = 'T';
+        } else if ( row == 1 ) {
+            line[32] = 'S';
+        } else if ( row == 63 ) {
+            line.fill( '^' );
+        }
+        map += line + '\n';
+    }
+    initGame( map );
+
+    Game& game = mRegistry.getGame();
+    QBENCHMARK {
+        game.sightCannons();
+    }
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <QCoreApplication>
+#include <QSignalSpy>
+#include <QTextStream>
+#include <QTimer>
+
+#include "benchmain.h"
+#include "controller/game.h"
+#include "util/persist.h"
+#include "util/recorder.h"
+
+BenchRegistry::~BenchRegistry()
+{
+    cleanup();
+}
+
+void BenchRegistry::cleanup()
+{
+    mWorker.purge();
+    if ( mWorkerPool ) {
+        mWorkerPool->purge();
+    }
+
+    deleteComponents();
+}
+
+void BenchRegistry::injectPersist( Persist* persist )
+{
+    delete mPersist;
+    mPersist = persist;
+    persist->setParent( this );
+}
+
+void BenchRegistry::injectRecorder( Recorder* recorder )
+{
+    delete mRecorder;
+    mRecorder = recorder;
+    recorder->setParent( this );
+}
+
+BenchMain::BenchMain()
+{
+}
+
+BenchMain::~BenchMain()
+{
+    cleanup();
+}
+
+void BenchMain::initGame( const QString& map )
+{
+    mMap = map;
+    QTextStream stream( &mMap );
+    Game& game = mRegistry.getGame();
+    game.init( &mRegistry );
+    game.getBoard()->load( stream );
+}
+
+bool BenchMain::waitFor( const std::function<bool()>& condition, int timeout )
+{
+    // Block until the next event rather than poll, so the wait ends as soon as the result is delivered. The timer's
+    // event wakes the loop when the time is up.
+    QTimer timer;
+    timer.setSingleShot( true );
+    timer.start( timeout );
+    while( !condition() ) {
+        if ( !timer.isActive() ) {
+            return false;
+        }
+        QCoreApplication::processEvents( QEventLoop::WaitForMoreEvents );
+    }
+    return true;
+}
+
+void BenchMain::cleanup()
+{
+    mRegistry.cleanup();
+}
+
+QString benchOpenMap( int width, int height )
+{
+    QString map;
+    for( int row = 0; row < height; ++row ) {
+        QString line( width, '.' );
+        if ( !row ) {
+            line[0] = 'T';
+        }
+        if ( row == height-1 ) {
+            line[width-1] = 'F';
+        }
+        map += line + '\n';
+    }
+    return map;
+}
+
+QString benchMazeMap( int width, int height )
+{
+    // a serpentine of stone walls on every other row, with the gap alternating sides
+    QString map;
+    for( int row = 0; row < height; ++row ) {
+        QString line( width, '.' );
+        if ( row & 1 ) {
+            line.fill( 'S' );
+            line[ (row & 2) ? 0 : width-1 ] = '.';
+        }
+        if ( !row ) {
+            line[0] = 'T';
+        }
+        if ( row == height-1 ) {
+            line[width-1] = 'F';
+        }
+        map += line + '\n';
+    }
+    return map;
+}
+
+int main( int argc, char *argv[] )
+{
+    QCoreApplication app( argc, argv );
+    app.setAttribute( Qt::AA_Use96Dpi, true );
+
+    // default to both human-readable and CSV output when no output is specified:
+    QStringList args = app.arguments();
+    if ( !args.contains( "-o" ) ) {
+        args << "-o" << "-,txt" << "-o" << "qltbench.csv,csv";
+    }
+
+    BenchMain bench;
+    return QTest::qExec( &bench, args );
+}
@@ -0,0 +1,84 @@
+#ifndef BENCHMAIN_H
+#define BENCHMAIN_H
+
+#include <functional>
+#include <QObject>
+#include <QTest>
+
+#include "controller/gameregistry.h"
+
+class Persist;
+class Recorder;
+
+class BenchRegistry : public GameRegistry
+{
+public:
+    BenchRegistry() = default;
+    ~BenchRegistry();
+
+    /**
+     * @brief reset the registry (used to cleanup after each benchmark is run)
+     */
+    void cleanup();
+
+    void injectPersist( Persist* persist );
+    void injectRecorder( Recorder* recorder );
+};
+
+/**
+ * @brief Benchmarks for the engine's hot paths. Built as the qltbench target (qmake CONFIG+=bench).
+ */
+class BenchMain : public QObject
+{
+    Q_OBJECT
+public:
+    BenchMain();
+    ~BenchMain();
+
+    /**
+     * @brief Load the game's master board from the given map text
+     */
+    void initGame( const QString& map );
+
+    /**
+     * @brief Process events until the given condition is met
+     * Waits on the event loop between checks, so the condition should be one that an event makes true.
+     * @param condition The condition to check after each event
+     * @param timeout Maximum milliseconds to wait
+     * @return The condition result
+     */
+    static bool waitFor( const std::function<bool()>& condition, int timeout = 5000 );
+
+private slots:
+    void benchBoardLoad_data();
+    void benchBoardLoad();
+
+    void benchPathFinder_data();
+    void benchPathFinder();
+    void benchTileDrag_data();
+    void benchTileDrag();
+
+    void benchShootThru_data();
+    void benchShootThru();
+    void benchSightCannons();
+
+    void benchPersistInit();
+    void benchPersistUpdate();
+
+    void benchRecorderRecord();
+    void benchRecorderReplay();
+
+    void cleanup();
+
+private:
+    QString mMap;
+    BenchRegistry mRegistry;
+};
+
+/**
+ * @brief Map text helpers
+ */
+QString benchOpenMap( int width, int height );
+QString benchMazeMap( int width, int height );
+
+#endif // BENCHMAIN_H
@@ -0,0 +1,88 @@
+#include "benchmain.h"
+#include "controller/game.h"
+#include "controller/pathfindercontroller.h"
+#include "controller/pathsearchaction.h"
+#include "model/board.h"
+#include "util/mapgenerator.h"
+
+void BenchMain::benchPathFinder_data()
+{
+    QTest::addColumn<QString>("map");
+
+    QTest::newRow("open 32x32") << benchOpenMap( 32, 32 );
+    QTest::newRow("open 64x64") << benchOpenMap( 64, 64 );
+    QTest::newRow("maze 32x32") << benchMazeMap( 32, 32 );
+    QTest::newRow("maze 64x64") << benchMazeMap( 64, 64 );
+
+    for( int size : { 64, 128, 256 } ) {
+        MapGenerator generator( size, size );
+        QString name = QString( "%1x%1" ).arg( size );
+        QTest::newRow( qPrintable("generated open "+name) ) << generator.generate( MapGenerator::OpenField );
+        QTest::newRow( qPrintable("generated maze "+name) ) << generator.generate( MapGenerator::Maze );
+    }
+}
+
+void BenchMain::benchPathFinder()
+{
+    QFETCH( QString, map );
+    initGame( map );
+
+    Board* board = mRegistry.getGame().getBoard();
+    PathFinderController& controller = mRegistry.getPathFinderController();
+    PathSearchAction& action = mRegistry.getPathToAction();
+    QVERIFY( action.setCriteria( TANK, board->getFlagPoint() ) );
+
+    bool received = false;
+    QObject context;
+    QObject::connect( &controller, &PathFinderController::testResult, &context, [&received]{ received = true; } );
+    QBENCHMARK {
+        received = false;
+        QVERIFY( controller.doAction( &action, true ) );
+        QVERIFY( waitFor( [&received]{ return received; } ) );
+    }
+    QVERIFY( action.isEnabled() );
+}
+
+void BenchMain::benchTileDrag_data()
+{
+    QTest::addColumn<QString>("map");
+
+    QString open = benchOpenMap( 32, 32 );
+    open[ 16*33 + 16 ] = 'M';
+    QTest::newRow("open 32x32") << open;
+
+    QString maze = benchMazeMap( 32, 32 );
+    maze[ 30*33 + 16 ] = 'M';
+    QTest::newRow("maze 32x32") << maze;
+}
+
+void BenchMain::benchTileDrag()
+{
+    QFETCH( QString, map );
+    initGame( map );
+
+    Board* board = mRegistry.getGame().getBoard();
+    const Piece* tile = nullptr;
+    for( const auto& piece : board->getPieceManager().getPieces() ) {
+        if ( piece.getType() == TILE ) {
+            tile = &piece;
+            break;
+        }
+    }
+    QVERIFY( tile );
+
+    PathFinderController& controller = mRegistry.getPathFinderController();
+    TileDragTestResult result;
+    result.setParent( &mRegistry );
+    PathSearchCriteria criteria;
+    QVERIFY( criteria.setTileDragCriteria( TANK, tile, &result ) );
+
+    bool received = false;
+    QObject context;
+    QObject::connect( &controller, &PathFinderController::testResult, &context, [&received]{ received = true; } );
+    QBENCHMARK {
+        received = false;
+        QVERIFY( controller.testCriteria( &criteria ) );
+        QVERIFY( waitFor( [&received]{ return received; } ) );
+    }
+}
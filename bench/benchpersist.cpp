@@ -0,0 +1,69 @@
+#include <QFile>
+
+#include "benchmain.h"
+#include "util/persist.h"
+#include "util/recorder.h"
+
+static const int SaveLevelCount = 47;
+
+static Persist* setupPersist( BenchRegistry& registry )
+{
+    auto persist = new Persist( "qltbench.sav" );
+    registry.injectPersist( persist );
+
+    QFile file( persist->getPath() );
+    if ( file.exists() && !file.remove() ) {
+        return nullptr;
+    }
+
+    persist->init( &registry );
+    if ( !BenchMain::waitFor( [persist]{ return !persist->updateInProgress(); } ) ) {
+        return nullptr;
+    }
+    return persist;
+}
+
+static bool persistLevel( Recorder& recorder, Persist& persist, int level, int count )
+{
+    recorder.onBoardLoaded( level );
+    for( int i = count; --i >= 0; ) {
+        recorder.recordMove( true, (i & 3) * 90 );
+    }
+    persist.onLevelUpdated( level );
+    return BenchMain::waitFor( [&persist]{ return !persist.updateInProgress(); }, 60*1000 );
+}
+
+static bool persistAllLevels( BenchRegistry& registry, Persist& persist )
+{
+    Recorder& recorder = registry.getRecorder();
+    for( int level = 1; level <= SaveLevelCount; ++level ) {
+        if ( !persistLevel( recorder, persist, level, 100 + level * 10 ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void BenchMain::benchPersistUpdate()
+{
+    Persist* persist = setupPersist( mRegistry );
+    QVERIFY( persist );
+    QVERIFY( persistAllLevels( mRegistry, *persist ) );
+
+    // rewrite each level over the populated save:
+    QBENCHMARK {
+        QVERIFY( persistAllLevels( mRegistry, *persist ) );
+    }
+}
+
+void BenchMain::benchPersistInit()
+{
+    Persist* persist = setupPersist( mRegistry );
+    QVERIFY( persist );
+    QVERIFY( persistAllLevels( mRegistry, *persist ) );
+
+    QBENCHMARK {
+        persist->init( &mRegistry );
+        QVERIFY( waitFor( [persist]{ return !persist->updateInProgress(); } ) );
+    }
+}
@@ -0,0 +1,74 @@
+#include "benchmain.h"
+#include "util/recorder.h"
+#include "util/recorderprivate.h"
+
+class NullRecorderPlayer : public RecorderPlayer
+{
+public:
+    NullRecorderPlayer() : mMoveCount(0)
+    {
+    }
+
+    void move( int /*direction*/ ) override
+    {
+        ++mMoveCount;
+    }
+
+    void fire( int /*count*/ ) override
+    {
+    }
+
+    bool setReplay( bool /*on*/ ) override
+    {
+        return false;
+    }
+
+    bool readerFinished() override
+    {
+        return false;
+    }
+
+    int mMoveCount;
+};
+
+static void recordMoves( Recorder& recorder, int level, int count )
+{
+    // loading a different level clears the recording:
+    recorder.onBoardLoaded( level );
+    for( int i = 0; i < count; ++i ) {
+        if ( i & 1 ) {
+            recorder.recordMove( true, -1 );
+        } else {
+            recorder.recordMove( true, (i & 6) * 45 );
+            recorder.recordShot();
+        }
+    }
+}
+
+void BenchMain::benchRecorderRecord()
+{
+    Recorder& recorder = mRegistry.getRecorder();
+    int level = 0;
+    QBENCHMARK {
+        recordMoves( recorder, ++level, Recorder::SaneMaxCapacity / 2 );
+    }
+}
+
+void BenchMain::benchRecorderReplay()
+{
+    Recorder& recorder = mRegistry.getRecorder();
+    recordMoves( recorder, 1, Recorder::SaneMaxCapacity / 2 );
+
+    QBENCHMARK {
+        if ( RecorderSource* source = recorder.source() ) {
+            RecorderReader reader( 0, *source );
+            NullRecorderPlayer player;
+            while( reader.consumeNext( &player ) ) {
+            }
+            QVERIFY( player.mMoveCount > 0 );
+            delete source;
+        } else {
+            QFAIL( "no source" );
+        }
+    }
+}
@@ -1,14 +1,28 @@
 #include <iostream>
 #include <QVariant>
 #include "animationstateaggregator.h"
+#include "gameclock.h"
 
-AnimationStateAggregator::AnimationStateAggregator(QObject *parent) : QObject(parent), mActiveCount{0}
+AnimationStateAggregator::AnimationStateAggregator(QObject *parent) : QObject(parent), mActiveCount{0}, mFinishPending{false}
 {
 }
 
 bool AnimationStateAggregator::active()
 {
-    return mActiveCount > 0;
+    return mActiveCount > 0 || mFinishPending;
+}
+
+void AnimationStateAggregator::setClock( GameClock* clock )
+{
+    mClock = clock;
+}
+
+void AnimationStateAggregator::deliverFinished()
+{
+    if ( mFinishPending ) {
+        mFinishPending = false;
+        emit finished();
+    }
 }
 
 void AnimationStateAggregator::onStateChanged( QAbstractAnimation::State newState, QAbstractAnimation::State oldState )
@@ -22,7 +36,12 @@ void AnimationStateAggregator::onStateChanged( QAbstractAnimation::State newStat
         if ( --mActiveCount <= 0 ) {
             mActiveCount = 0;
 //            std::cout << "AnimationStateAggregator " << qPrintable(objectName()) << ": finished" << std::endl;
-            emit finished();
+            if ( mClock ) {
+                mFinishPending = true;
+                mClock->scheduleFinished();
+            } else {
+                emit finished();
+            }
         }
     }
 }
@@ -30,4 +49,5 @@ void AnimationStateAggregator::onStateChanged( QAbstractAnimation::State newStat
 void AnimationStateAggregator::reset()
 {
     mActiveCount = 0;
+    mFinishPending = false;
 }
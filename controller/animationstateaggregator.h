@@ -3,6 +3,9 @@
 
 #include <QObject>
 #include <QAbstractAnimation>
+#include <QPointer>
+
+class GameClock;
 
 /**
  * @brief The StateAggregator class
@@ -22,6 +25,17 @@ public:
      */
     bool active();
 
+    /**
+     * @brief Defer the finished signal to the given clock's next delivery rather than emitting it when the last
+     * state object stops. Called by GameClock::addAggregator.
+     */
+    void setClock( GameClock* clock );
+
+    /**
+     * @brief Emit a finished signal deferred by the clock
+     */
+    void deliverFinished();
+
 signals:
     /**
      * @brief finished
@@ -43,7 +57,9 @@ public slots:
     void reset();
 
 private:
+    QPointer<GameClock> mClock;
     int mActiveCount;
+    bool mFinishPending;
 };
 
 #endif // ANIMATIONSTATEAGGREGATOR_H
@@ -0,0 +1,236 @@
+#include <algorithm>
+#include <thread>
+#include <QCoreApplication>
+#include <QFileDevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include "evalserver.h"
+#include "game.h"
+#include "gameregistry.h"
+#include "movecontroller.h"
+#include "model/board.h"
+#include "model/level.h"
+#include "util/trace.h"
+
+// limit on the requests read ahead of the evaluation threads
+constexpr int MaxQueuedPerThread = 4;
+
+/**
+ * @brief A move controller which only plans; the tank is never woken up to carry out the moves
+ */
+class EvalMoveController : public MoveController
+{
+public:
+    bool canWakeup() override
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief A registry for evaluation. Components are still created on first use, so an evaluator only builds the game,
+ * its boards, the planning controller and the shot models it needs.
+ */
+class EvalRegistry : public GameRegistry
+{
+public:
+    EvalRegistry()
+    {
+        mMoveController = new EvalMoveController();
+        mMoveController->setParent( this );
+    }
+};
+
+Evaluator::Evaluator() : mRegistry(new EvalRegistry())
+{
+    // nothing is animated so the thread's animations are left alone
+    mRegistry->getGame().init( mRegistry, false );
+}
+
+Evaluator::~Evaluator()
+{
+    delete mRegistry;
+}
+
+bool Evaluator::evaluate( const Board& board, const QString& moves, EvalResult* result )
+{
+    for( QChar c : moves ) {
+        if ( !c.isSpace() && !QString("UDLRF").contains( c.toUpper() ) ) {
+            return false;
+        }
+    }
+
+    // this thread runs no event loop; deliver anything queued by the previous evaluation
+    QCoreApplication::sendPostedEvents();
+
+    Game& game = mRegistry->getGame();
+    game.getBoard()->load( &board );
+    MoveController& moveController = mRegistry->getMoveController();
+
+    *result = { false, false, 0, 0 };
+    ModelVector tankVector = game.getBoard()->getTankStartVector();
+    for( QChar c : moves ) {
+        switch( c.toUpper().unicode() ) {
+        case 'U': moveController.move(   0 ); break;
+        case 'R': moveController.move(  90 ); break;
+        case 'D': moveController.move( 180 ); break;
+        case 'L': moveController.move( 270 ); break;
+        case 'F': moveController.fire(  -1 ); break;
+        default:
+            continue;
+        }
+        ++result->mSteps;
+
+        if ( Piece* lastMove = moveController.getMoves().getBack() ) {
+            tankVector = *lastMove;
+        }
+        Board* futureBoard = game.getBoard( true );
+        if ( futureBoard->tileAt( tankVector ) == FLAG ) {
+            result->mSolved = true;
+            break;
+        }
+        if ( game.findSightingCannon( futureBoard, tankVector ) ) {
+            result->mKilled = true;
+            break;
+        }
+    }
+
+    result->mHash = game.getBoard( true )->getSnapshot()->getHash()
+                  ^ (static_cast<std::uint64_t>( (tankVector.mRow*BoardMaxWidth + tankVector.mCol) * 4 + tankVector.mAngle/90 )
+                     * 0x9e3779b97f4a7c15ULL);
+    return true;
+}
+
+/**
+ * @brief Evaluates requests taken from the server's queue until the input is exhausted
+ */
+class EvalThread : public QThread
+{
+public:
+    EvalThread( EvalServer& server ) : mServer(server)
+    {
+    }
+
+    void run() override
+    {
+        TRACE_THREAD_NAME( "eval" );
+        Evaluator evaluator;
+        QByteArray request;
+        while( mServer.takeRequest( &request ) ) {
+            mServer.respond( evaluator, request );
+        }
+    }
+
+private:
+    EvalServer& mServer;
+};
+
+EvalServer::EvalServer( unsigned threadCount ) : mThreadCount(threadCount), mInputDone{false}, mOutput{nullptr}
+{
+    if ( !mThreadCount ) {
+        mThreadCount = std::max( std::thread::hardware_concurrency(), 1U );
+    }
+}
+
+EvalServer::~EvalServer() = default;
+
+int EvalServer::preload()
+{
+    LevelList levels;
+    levels.load();
+    for( int i = 0; i < levels.size(); ++i ) {
+        Board* board = new Board();
+        board->load( levels.numberAt( i ) );
+        addBoard( board );
+    }
+    return static_cast<int>( mBoards.size() );
+}
+
+void EvalServer::addBoard( Board* board )
+{
+    mBoards[board->getLevel()].reset( board );
+}
+
+void EvalServer::serve( QIODevice& input, QIODevice& output )
+{
+    mOutput = &output;
+    mInputDone = false;
+
+    std::vector<std::unique_ptr<EvalThread>> threads;
+    for( unsigned i = 0; i < mThreadCount; ++i ) {
+        threads.emplace_back( new EvalThread( *this ) );
+        threads.back()->start();
+    }
+
+    QByteArray line;
+    while( !(line = input.readLine()).isEmpty() ) {
+        line = line.trimmed();
+        if ( !line.isEmpty() ) {
+            std::unique_lock<std::mutex> lock( mQueueMutex );
+            mQueueChanged.wait( lock, [this]() { return mQueue.size() < mThreadCount * MaxQueuedPerThread; } );
+            mQueue.push_back( line );
+            mQueueChanged.notify_all();
+        }
+    }
+
+    {   std::lock_guard<std::mutex> guard( mQueueMutex );
+        mInputDone = true;
+        mQueueChanged.notify_all();
+    }
+    for( auto& thread : threads ) {
+        thread->wait();
+    }
+    mOutput = nullptr;
+}
+
+bool EvalServer::takeRequest( QByteArray* request )
+{
+    std::unique_lock<std::mutex> lock( mQueueMutex );
+    mQueueChanged.wait( lock, [this]() { return !mQueue.empty() || mInputDone; } );
+    if ( mQueue.empty() ) {
+        return false;
+    }
+    *request = mQueue.front();
+    mQueue.pop_front();
+    mQueueChanged.notify_all();
+    return true;
+}
+
+void EvalServer::respond( Evaluator& evaluator, const QByteArray& request )
+{
+    QJsonObject response;
+    QJsonDocument document = QJsonDocument::fromJson( request );
+    if ( !document.isObject() ) {
+        response["error"] = "malformed request";
+    } else {
+        QJsonObject object = document.object();
+        response["id"] = object.value( "id" );
+
+        auto it = mBoards.find( object.value( "level" ).toInt() );
+        EvalResult result;
+        if ( it == mBoards.end() ) {
+            response["error"] = "unknown level";
+        } else if ( !object.value( "moves" ).isString() ) {
+            response["error"] = "missing moves";
+        } else if ( !evaluator.evaluate( *it->second, object.value( "moves" ).toString(), &result ) ) {
+            response["error"] = "unknown move command";
+        } else {
+            response["solved"] = result.mSolved;
+            response["killed"] = result.mKilled;
+            response["steps"]  = result.mSteps;
+            // as a string since JSON numbers can't hold 64 bits
+            response["hash"]   = QString::number( static_cast<qulonglong>( result.mHash ), 16 ).rightJustified( 16, '0' );
+        }
+    }
+
+    QByteArray line = QJsonDocument( response ).toJson( QJsonDocument::Compact );
+    line.append( '\n' );
+
+    std::lock_guard<std::mutex> guard( mOutputMutex );
+    mOutput->write( line );
+    if ( QFileDevice* file = qobject_cast<QFileDevice*>( mOutput ) ) {
+        file->flush();
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef EVALSERVER_H
+#define EVALSERVER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+
+class Board;
+class GameRegistry;
+class EvalThread;
+
+/**
+ * @brief The outcome of evaluating a move list
+ */
+typedef struct {
+    bool mSolved;        // the tank reached the flag
+    bool mKilled;        // a cannon has the tank in its sights
+    int mSteps;          // commands consumed up to and including the one that decided the outcome
+    std::uint64_t mHash; // the final board state combined with the tank's vector
+} EvalResult;
+
+/**
+ * @brief A reusable headless game for evaluating move lists.
+ * Moves are planned onto the future board the same way the tank's move queue plans them during play, but nothing is
+ * animated and the game clock isn't installed. Must be used on the thread which created it.
+ */
+class Evaluator
+{
+public:
+    Evaluator();
+    ~Evaluator();
+
+    /**
+     * @brief Evaluate a move list from a board's starting position
+     * @param board The starting board. It is only read, so may be shared between evaluators on other threads.
+     * @param moves The commands. U, R, D and L turn or move the tank up, right, down or left; F fires. Whitespace is
+     * ignored.
+     * @param result Receives the outcome
+     * @return false if the moves contain an unknown command
+     */
+    bool evaluate( const Board& board, const QString& moves, EvalResult* result );
+
+private:
+    GameRegistry* mRegistry;
+};
+
+/**
+ * @brief Serves move list evaluations as JSON lines.
+ * Each request line is an object of the form {"id":..., "level":n, "moves":"..."}. Requests are evaluated concurrently
+ * against boards loaded once up front and results are written as they complete (i.e. not necessarily in request order):
+ * {"id":..., "solved":bool, "killed":bool, "steps":n, "hash":"..."} or {"id":..., "error":"..."}.
+ */
+class EvalServer
+{
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount The number of evaluation threads. 0 selects the hardware concurrency.
+     */
+    explicit EvalServer( unsigned threadCount = 0 );
+    ~EvalServer();
+
+    /**
+     * @brief Load the boards of every level in the level list
+     * @return The number of boards loaded
+     */
+    int preload();
+
+    /**
+     * @brief Add a board to serve requests for. The board is keyed by its level number.
+     * @param board The board. Ownership is transferred to this server.
+     */
+    void addBoard( Board* board );
+
+    /**
+     * @brief Evaluate the requests read from input until the end of input is reached
+     * @param input The source of request lines
+     * @param output Receives the result lines
+     */
+    void serve( QIODevice& input, QIODevice& output );
+
+private:
+    bool takeRequest( QByteArray* request );
+    void respond( Evaluator& evaluator, const QByteArray& request );
+
+    unsigned mThreadCount;
+    std::map<int,std::unique_ptr<Board>> mBoards;
+
+    std::mutex mQueueMutex;
+    std::condition_variable mQueueChanged;
+    std::deque<QByteArray> mQueue;
+    bool mInputDone;
+
+    std::mutex mOutputMutex;
+    QIODevice* mOutput;
+
+    friend class EvalThread;
+};
+
+#endif // EVALSERVER_H
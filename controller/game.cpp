@@ -20,12 +20,13 @@
 #include "util/persist.h"
 #include "util/imageutils.h"
 
-Game::Game() : mDesiredLevel{0}
+Game::Game() : mRegistry{nullptr}, mDesiredLevel{0}
 {
 }
 
-void Game::init( GameRegistry* registry )
+void Game::init( GameRegistry* registry, bool clocked )
 {
+    mRegistry = registry;
     registry->getTank().init( registry );
 
     MoveController& moveController = registry->getMoveController();
@@ -33,7 +34,12 @@ void Game::init( GameRegistry* registry )
 
     registry->getActiveCannon().init( registry, CANNON, QColor(255,50,83) );
 
-    registry->getPathFinderController().init();
+    PathFinderController& pathFinderController = registry->getPathFinderController();
+    pathFinderController.init();
+    // rank paths by how long the tank takes to drive them
+    Tank& tank = registry->getTank();
+    pathFinderController.setPathCosts( tank.getMoveDuration( SpeedController::NormalSpeed ),
+                                       tank.getRotateDuration( SpeedController::NormalSpeed ) );
 
     AnimationStateAggregator& moveAggregate = registry->getMoveAggregate(); moveAggregate.setObjectName("MoveAggregate");
     AnimationStateAggregator& shotAggregate = registry->getShotAggregate(); shotAggregate.setObjectName("ShotAggregate");
@@ -42,13 +48,21 @@ void Game::init( GameRegistry* registry )
     Push& shotPush = registry->getShotPush(); shotPush.init( registry );
     QObject::connect( &tankPush, &Push::stateChanged, &moveAggregate, &AnimationStateAggregator::onStateChanged, Qt::DirectConnection );
     QObject::connect( &shotPush, &Push::stateChanged, &shotAggregate, &AnimationStateAggregator::onStateChanged, Qt::DirectConnection );
-    QObject::connect( &moveAggregate, &AnimationStateAggregator::finished, this, &Game::onMoveAggregatorFinished, Qt::QueuedConnection );
+    QObject::connect( &moveAggregate, &AnimationStateAggregator::finished, this, &Game::onMoveAggregatorFinished, Qt::DirectConnection );
     QObject::connect( &shotAggregate, &AnimationStateAggregator::finished, this, &Game::sightCannons, Qt::DirectConnection );
 
+    // drive all animations from the one clock, which delivers the move completion ahead of the shot completion
+    GameClock& clock = registry->getSpeedController().getClock();
+    clock.addAggregator( &moveAggregate );
+    clock.addAggregator( &shotAggregate );
+    if ( clocked ) {
+        clock.activate();
+    }
+
     mFutureDelta.init( &mBoard, &mFutureBoard );
     QObject::connect( &moveController, &MoveController::invalidatePushIdDelineation, &mFutureDelta.getPieceManager(), &PieceSetManager::invalidatePushIdDelineation, Qt::DirectConnection );
 
-    QObject::connect( &mBoard, &Board::tileChangedAt, this, &Game::onBoardTileChanged, Qt::DirectConnection );
+    QObject::connect( &mBoard, &Board::changesCommitted, this, &Game::onBoardChanged, Qt::DirectConnection );
     QObject::connect( &mBoard, &Board::boardLoading,  this, &Game::onBoardLoading,     Qt::DirectConnection );
     QObject::connect( &mBoard, &Board::boardLoaded,   this, &Game::onBoardLoaded,      Qt::DirectConnection );
     QObject::connect( &registry->getBoardPool(), &BoardPool::boardLoaded, this, &Game::onPoolLoaded, Qt::QueuedConnection );
@@ -74,7 +88,7 @@ bool Game::isBoardLoaded()
 void Game::onPoolLoaded( int level )
 {
     if ( mDesiredLevel == level ) {
-        if ( GameRegistry* registry = getRegistry(this) ) {
+        if ( GameRegistry* registry = mRegistry ) {
             if ( Board* board = registry->getBoardPool().find( level ) ) {
                 mBoard.load( board );
             }
@@ -84,7 +98,7 @@ void Game::onPoolLoaded( int level )
 
 void Game::onBoardLoaded( int level )
 {
-    if ( GameRegistry* registry = getRegistry(this) ) {
+    if ( GameRegistry* registry = mRegistry ) {
         mFutureDelta.enable( false );
         registry->getMoveAggregate().reset();
         registry->getShotAggregate().reset();
@@ -125,7 +139,7 @@ bool Game::canMoveFrom( PieceType what, int angle, ModelPoint *point, bool futur
     if ( getAdjacentPosition( angle, point ) ) {
         if ( what != TANK ) {
             // prevent pushing it onto the tank:
-            if ( GameRegistry* registry = getRegistry(this) ) {
+            if ( GameRegistry* registry = mRegistry ) {
                 if ( point->equals( registry->getMoveController().getDragFocusVector( futuristic ? MOVE : TANK ) ) ) {
                     return false;
                 }
@@ -146,7 +160,7 @@ bool Game::canCannonSightThru( Board* board, ModelPoint point )
             return false;
         }
 
-        if ( GameRegistry* registry = getRegistry(this) ) {
+        if ( GameRegistry* registry = mRegistry ) {
             if ( registry->getTankPush().occupies( point )
               || registry->getShotPush().occupies( point ) ) {
                 return false;
@@ -162,68 +176,72 @@ bool Game::canCannonSightThru( Board* board, ModelPoint point )
     }
 }
 
-void Game::sightCannons()
+bool Game::findSightingCannon( Board* board, const ModelPoint& point, ModelVector* cannon )
 {
-    if ( GameRegistry* registry = getRegistry(this) ) {
-        // fire any cannon
-        const PieceSet& pieces = mBoard.getPieceManager().getPieces();
-        bool sighted = false;
-        int tankCol = registry->getTank().getCol();
-        int tankRow = registry->getTank().getRow();
-        int fireAngle, fireCol, fireRow;
-
-        for( auto it = pieces.cbegin(); !sighted && it != pieces.cend(); ++it ) {
-            if ( (*it)->getType() == CANNON ) {
-                fireAngle = (*it)->getAngle();
-                if ( tankCol == (*it)->getCol() ) {
-                    fireRow = (*it)->getRow();
-                    int dir;
-                    if ( fireAngle == 0 && tankRow < fireRow ) {
-                        dir = -1;
-                    } else if ( fireAngle == 180 && tankRow > fireRow ) {
-                        dir = 1;
-                    } else {
-                        continue;
+    const PieceVector& pieces = board->getPieceManager().getPieces();
+    for( auto it = pieces.cbegin(); it != pieces.cend(); ++it ) {
+        if ( it->getType() == CANNON ) {
+            int fireAngle = it->getAngle();
+            bool sighted = false;
+            if ( point.mCol == it->getCol() ) {
+                int dir;
+                if ( fireAngle == 0 && point.mRow < it->getRow() ) {
+                    dir = -1;
+                } else if ( fireAngle == 180 && point.mRow > it->getRow() ) {
+                    dir = 1;
+                } else {
+                    continue;
+                }
+                for( int row = it->getRow()+dir; ; row += dir ) {
+                    if ( row == point.mRow ) {
+                        sighted = true;
+                        break;
                     }
-                    for( int row = fireRow+dir; ; row += dir ) {
-                        if ( row == tankRow ) {
-                            fireCol = tankCol;
-                            sighted = true;
-                            break;
-                        }
-                        if ( !canCannonSightThru( &mBoard, ModelPoint( tankCol, row ) ) ) {
-                            break;
-                        }
+                    if ( !canCannonSightThru( board, ModelPoint( point.mCol, row ) ) ) {
+                        break;
                     }
-                } else if ( tankRow == (*it)->getRow() ) {
-                    fireCol = (*it)->getCol();
-                    int dir;
-                    if ( fireAngle == 270 && tankCol < fireCol ) {
-                        dir = -1;
-                    } else if ( fireAngle == 90 && tankCol > fireCol ) {
-                        dir = 1;
-                    } else {
-                        continue;
+                }
+            } else if ( point.mRow == it->getRow() ) {
+                int dir;
+                if ( fireAngle == 270 && point.mCol < it->getCol() ) {
+                    dir = -1;
+                } else if ( fireAngle == 90 && point.mCol > it->getCol() ) {
+                    dir = 1;
+                } else {
+                    continue;
+                }
+                for( int col = it->getCol()+dir; ; col += dir ) {
+                    if ( col == point.mCol ) {
+                        sighted = true;
+                        break;
                     }
-                    for( int col = fireCol+dir; ; col += dir ) {
-                        if ( col == tankCol ) {
-                            fireRow = tankRow;
-                            sighted = true;
-                            break;
-                        }
-                        if ( !canCannonSightThru( &mBoard, ModelPoint( col, tankRow ) ) ) {
-                            break;
-                        }
+                    if ( !canCannonSightThru( board, ModelPoint( col, point.mRow ) ) ) {
+                        break;
                     }
                 }
             }
+
+            if ( sighted ) {
+                if ( cannon ) {
+                    *cannon = ModelVector( it->getCol(), it->getRow(), fireAngle );
+                }
+                return true;
+            }
         }
+    }
+    return false;
+}
 
-        if ( sighted ) {
+void Game::sightCannons()
+{
+    if ( GameRegistry* registry = mRegistry ) {
+        // fire any cannon
+        ModelVector cannon;
+        if ( findSightingCannon( &mBoard, registry->getTank().getPoint(), &cannon ) ) {
             Shooter& activeCannon = registry->getActiveCannon();
-            activeCannon.setViewX( fireCol*24 );
-            activeCannon.setViewY( fireRow*24 );
-            activeCannon.setViewRotation( fireAngle );
+            activeCannon.setViewX( cannon.mCol*24 );
+            activeCannon.setViewY( cannon.mRow*24 );
+            activeCannon.setViewRotation( cannon.mAngle );
             activeCannon.fire();
         }
     }
@@ -232,6 +250,9 @@ void Game::sightCannons()
 void Game::onPushed(PieceType type, const ModelPoint& point, int pieceAngle )
 {
     mBoard.applyPushResult( type, point, pieceAngle );
+    if ( type == TILE && mBoard.isDeadSquare( point ) ) {
+        emit tileStranded( point, false );
+    }
 }
 
 void Game::onMoveAggregatorFinished()
@@ -239,7 +260,7 @@ void Game::onMoveAggregatorFinished()
     if ( !mFutureDelta.getPieceManager().size() ) {
         mFutureDelta.enable( false );
     }
-    if ( GameRegistry* registry = getRegistry(this) ) {
+    if ( GameRegistry* registry = mRegistry ) {
         registry->getSpeedController().stepSpeed();
         Tank& tank = registry->getTank();
 
@@ -281,9 +302,9 @@ void Game::onMoveAggregatorFinished()
     }
 }
 
-void Game::onBoardTileChanged( const ModelPoint& point )
+void Game::onBoardChanged( const BoardChangeSet& changes )
 {
-    if ( mBoard.tileAt( point ) == DIRT ) {
+    if ( changes.mDirtExposed ) {
         sightCannons();
     }
 }
@@ -307,12 +328,34 @@ bool Game::canPushPiece( const Piece* piece, int fromAngle )
     }
 }
 
-bool Game::canPlaceAt(PieceType what, ModelPoint point, int fromAngle, Board* board, Piece **pushPiece )
+/**
+ * @brief The placement rule, shared by boards and board snapshots
+ * @param what The type of piece
+ * @param tile The tile of the square to consider
+ * @param placeOnPiece Decides the tiles which can hold pieces; returns whether the square's piece (if any) allows it
+ * @return true if the placement is legal
+ */
+template<typename PieceRule>
+static bool placeRule( PieceType what, TileType tile, PieceRule placeOnPiece )
 {
-    switch( board->tileAt( point ) ) {
+    switch( tile ) {
     case DIRT:
     case TILE_SUNK:
-    {   Piece* hit = board->getPieceManager().pieceAt( point );
+        return placeOnPiece();
+    case FLAG:
+        return what == TANK;
+    case WATER:
+        return what != TANK;
+    default:
+        ;
+    }
+    return false;
+}
+
+bool Game::canPlaceAt(PieceType what, ModelPoint point, int fromAngle, Board* board, Piece **pushPiece )
+{
+    return placeRule( what, board->tileAt( point ), [&]() -> bool {
+        Piece* hit = board->getPieceManager().pieceAt( point );
         if ( hit ) {
             if ( fromAngle >= 0 ) {
                 if ( canPushPiece( hit, fromAngle ) ) {
@@ -327,15 +370,7 @@ bool Game::canPlaceAt(PieceType what, ModelPoint point, int fromAngle, Board* bo
             return false;
         }
         return true;
-    }
-    case FLAG:
-        return what == TANK;
-    case WATER:
-        return what != TANK;
-    default:
-        ;
-    }
-    return false;
+    } );
 }
 
 bool getShotReflection( int mirrorAngle, int *shotAngle )
@@ -415,169 +450,230 @@ bool canShootThruPush( QPoint& centerOfSquare, int angle, Push& push, QPoint *hi
     return true;
 }
 
+/**
+ * @brief The laser rule, shared by boards and board snapshots
+ * @param tile The tile of the square to consider
+ * @param angle Inputs the laser direction as it enters the square; outputs the direction the laser exits the square
+ * @param shootThruPiece Decides the tiles which can hold pieces; returns whether the shot continues past the square
+ * @param hitTile Called with the tile when the tile stops the shot
+ * @return true if the the shot is continuing to advance past the square or false if the shot hit something
+ */
+template<typename PieceRule, typename TileHit>
+static bool shootThruRule( TileType tile, int *angle, PieceRule shootThruPiece, TileHit hitTile )
+{
+    switch( tile ) {
+    case DIRT:
+    case TILE_SUNK:
+        return shootThruPiece();
+
+    case WATER:
+    case FLAG:
+        return true;
+
+    case STONE_SLIT:    if ( *angle == 90 || *angle == 270 ) return true; break;
+    case STONE_SLIT_90: if ( *angle ==  0 || *angle == 180 ) return true; break;
+
+    case STONE_MIRROR:     if ( getShotReflection(   0, angle ) ) return true; break;
+    case STONE_MIRROR__90: if ( getShotReflection(  90, angle ) ) return true; break;
+    case STONE_MIRROR_180: if ( getShotReflection( 180, angle ) ) return true; break;
+    case STONE_MIRROR_270: if ( getShotReflection( 270, angle ) ) return true; break;
+
+    default:
+        ;
+    }
+    hitTile( tile );
+    return false;
+}
+
+bool Game::canPlaceAt( PieceType what, const ModelPoint& point, const BoardSnapshot& snapshot )
+{
+    return placeRule( what, snapshot.tileAt( point ), [&]() {
+        return snapshot.pieceAt( point ) == NONE;
+    } );
+}
+
+bool Game::canShootThru( const BoardSnapshot& snapshot, const ModelPoint& point, int *angle )
+{
+    return shootThruRule( snapshot.tileAt( point ), angle,
+        [&]() -> bool {
+            int pieceAngle;
+            switch( snapshot.pieceAt( point, &pieceAngle ) ) {
+            case NONE:
+                return true;
+            case TILE_MIRROR:
+                return getShotReflection( pieceAngle, angle );
+            default:
+                ;
+            }
+            return false;
+        },
+        []( TileType ) {
+        } );
+}
+
 bool Game::canShootThru( const ModelPoint& point, int *angle, FutureChange *change, bool apply, Shooter* source,
                          QPoint *hitPoint )
 {
     bool futuristic = (change != nullptr);
     Board* board = getBoard(futuristic);
 
-    switch( board->tileAt( point ) ) {
-    case DIRT:
-    case TILE_SUNK:
-    {   Piece* hitPiece = board->getPieceManager().pieceAt( point );
-        if ( hitPiece ) {
-            switch( hitPiece->getType() ) {
-            case TILE_MIRROR:
-                if ( getShotReflection( hitPiece->getAngle(), angle ) ) {
-                    return true;
+    return shootThruRule( board->tileAt( point ), angle,
+        [&]() {
+            return canShootThruPiece( board, point, angle, change, apply, source, hitPoint );
+        },
+        [&]( TileType tile ) {
+            switch( tile ) {
+            case WOOD:
+                if ( apply ) {
+                    if ( futuristic ) {
+                        mFutureDelta.enable();
+                        board = &mFutureBoard;
+                    }
+                    board->setTileAt( WOOD_DAMAGED, point );
+                }
+                if ( change ) {
+                    change->changeType = TILE_CHANGE;
+                    change->point = point;
+                    change->u.tileType = WOOD;
                 }
                 break;
-
-            case CANNON:
-            {   int pieceAngle = hitPiece->getAngle();
-                if ( abs( pieceAngle - *angle ) == 180 ) {
-                    if ( futuristic && apply ) {
+            case WOOD_DAMAGED:
+                if ( apply ) {
+                    if ( futuristic ) {
                         mFutureDelta.enable();
                         board = &mFutureBoard;
                     }
-                    if ( change ) {
-                        change->changeType = PIECE_ERASED;
-                        change->point = point;
-                        change->u.erase.pieceType = CANNON;
-                        change->u.erase.pieceAngle = pieceAngle;
-                        change->u.erase.previousPushedId = hitPiece->getPreviousPushedId();
-                    }
-                    if ( apply ) {
-                        board->getPieceManager().eraseAt( point );
-                    }
-
-                    if ( hitPoint ) {
-                        centerToEntryPoint( *angle, hitPoint );
-                    }
-                    return false;
+                    board->setTileAt( DIRT, point );
+                }
+                if ( change ) {
+                    change->changeType = TILE_CHANGE;
+                    change->point = point;
+                    change->u.tileType = WOOD_DAMAGED;
                 }
-            }
                 break;
 
             default:
                 ;
             }
 
-            // push it:
-            ModelPoint toPoint( point );
-            if ( canMoveFrom( hitPiece->getType(), *angle, &toPoint, futuristic ) ) {
-                if ( futuristic ) {
-                    change->changeType = PIECE_PUSHED;
-                    change->point = toPoint;
-                    change->u.multiPush.pieceType = hitPiece->getType();
-                    change->u.multiPush.pieceAngle = hitPiece->getAngle();
-                    change->u.multiPush.direction = *angle;
-                    change->u.multiPush.count = 1;
-                    change->u.multiPush.previousPushedId = hitPiece->getPushedId();
-                    if ( apply ) {
-                        onFuturePush( hitPiece, *angle );
-                    }
-                } else if ( apply ) {
-                    SimplePiece simple( hitPiece );
-                    board->getPieceManager().eraseAt( point );
-                    if ( GameRegistry* registry = getRegistry(this) ) {
-                        registry->getShotPush().start( simple, point, toPoint );
-                    }
-                }
+            if ( hitPoint ) {
+                centerToEntryPoint( *angle, hitPoint );
+            }
+        } );
+}
+
+bool Game::canShootThruPiece( Board* board, const ModelPoint& point, int *angle, FutureChange *change, bool apply,
+                              Shooter* source, QPoint *hitPoint )
+{
+    bool futuristic = (change != nullptr);
+
+    Piece* hitPiece = board->getPieceManager().pieceAt( point );
+    if ( hitPiece ) {
+        switch( hitPiece->getType() ) {
+        case TILE_MIRROR:
+            if ( getShotReflection( hitPiece->getAngle(), angle ) ) {
+                return true;
             }
             break;
-        }
 
-        if ( isMasterBoard(board) ) {
-            if ( GameRegistry* registry = getRegistry(this) ) {
-                QPoint centerOfSquare = point.toViewCenterSquare();
-                if ( !canShootThruPush( centerOfSquare, *angle, registry->getTankPush(), hitPoint ) ) {
-                    return false;
+        case CANNON:
+        {   int pieceAngle = hitPiece->getAngle();
+            if ( abs( pieceAngle - *angle ) == 180 ) {
+                if ( futuristic && apply ) {
+                    mFutureDelta.enable();
+                    board = &mFutureBoard;
                 }
-                if ( !canShootThruPush( centerOfSquare, *angle, registry->getShotPush(), hitPoint ) ) {
-                    return false;
+                if ( change ) {
+                    change->changeType = PIECE_ERASED;
+                    change->point = point;
+                    change->u.erase.pieceType = CANNON;
+                    change->u.erase.pieceAngle = pieceAngle;
+                    change->u.erase.previousPushedId = hitPiece->getPreviousPushedId();
+                }
+                if ( apply ) {
+                    board->getPieceManager().eraseAt( point );
                 }
 
-                // for the tank, vet that the distance is greater than zero to avoid undesireable self-inflicted wounds:
-                if ( source ) {
-                    Tank& tank = registry->getTank();
-                    if ( (source->getType() != TANK || source->getShot().getDistance())
-                         && tank.getRect().contains(centerOfSquare) ) {
-                        switch( *angle ) {
-                        case  90:
-                        case 270:
-                            if ( hitPoint ) {
-                                hitPoint->setX( tank.getViewX().toInt()+24/2 );
-                                centerToEntryPoint( *angle, hitPoint );
-                            }
-                            break;
-                        case   0:
-                        case 180:
-                            if ( hitPoint ) {
-                                hitPoint->setY( tank.getViewY().toInt()+24/2 );
-                                centerToEntryPoint( *angle, hitPoint );
-                            }
-                            break;
-                        }
-                        if ( apply ) {
-                            source->getShot().setIsKill();
-                        }
-                        return false;
-                    }
+                if ( hitPoint ) {
+                    centerToEntryPoint( *angle, hitPoint );
                 }
+                return false;
             }
         }
-        return true;
-    }
-    case WATER:
-    case FLAG:
-        return true;
-
-    case STONE_SLIT:    if ( *angle == 90 || *angle == 270 ) return true; break;
-    case STONE_SLIT_90: if ( *angle ==  0 || *angle == 180 ) return true; break;
-
-    case STONE_MIRROR:     if ( getShotReflection(   0, angle ) ) return true; break;
-    case STONE_MIRROR__90: if ( getShotReflection(  90, angle ) ) return true; break;
-    case STONE_MIRROR_180: if ( getShotReflection( 180, angle ) ) return true; break;
-    case STONE_MIRROR_270: if ( getShotReflection( 270, angle ) ) return true; break;
+            break;
 
-    case WOOD:
-        if ( apply ) {
-            if ( futuristic ) {
-                mFutureDelta.enable();
-                board = &mFutureBoard;
-            }
-            board->setTileAt( WOOD_DAMAGED, point );
+        default:
+            ;
         }
-        if ( change ) {
-            change->changeType = TILE_CHANGE;
-            change->point = point;
-            change->u.tileType = WOOD;
-        }
-        break;
-    case WOOD_DAMAGED:
-        if ( apply ) {
+
+        // push it:
+        ModelPoint toPoint( point );
+        if ( canMoveFrom( hitPiece->getType(), *angle, &toPoint, futuristic ) ) {
             if ( futuristic ) {
-                mFutureDelta.enable();
-                board = &mFutureBoard;
+                change->changeType = PIECE_PUSHED;
+                change->point = toPoint;
+                change->u.multiPush.pieceType = hitPiece->getType();
+                change->u.multiPush.pieceAngle = hitPiece->getAngle();
+                change->u.multiPush.direction = *angle;
+                change->u.multiPush.count = 1;
+                change->u.multiPush.previousPushedId = hitPiece->getPushedId();
+                if ( apply ) {
+                    onFuturePush( hitPiece, *angle );
+                }
+            } else if ( apply ) {
+                SimplePiece simple( hitPiece );
+                board->getPieceManager().eraseAt( point );
+                if ( GameRegistry* registry = mRegistry ) {
+                    registry->getShotPush().start( simple, point, toPoint );
+                }
             }
-            board->setTileAt( DIRT, point );
         }
-        if ( change ) {
-            change->changeType = TILE_CHANGE;
-            change->point = point;
-            change->u.tileType = WOOD_DAMAGED;
+        if ( hitPoint ) {
+            centerToEntryPoint( *angle, hitPoint );
         }
-        break;
-
-    default:
-        ;
+        return false;
     }
 
-    if ( hitPoint ) {
-        centerToEntryPoint( *angle, hitPoint );
+    if ( isMasterBoard(board) ) {
+        if ( GameRegistry* registry = mRegistry ) {
+            QPoint centerOfSquare = point.toViewCenterSquare();
+            if ( !canShootThruPush( centerOfSquare, *angle, registry->getTankPush(), hitPoint ) ) {
+                return false;
+            }
+            if ( !canShootThruPush( centerOfSquare, *angle, registry->getShotPush(), hitPoint ) ) {
+                return false;
+            }
+
+            // for the tank, vet that the distance is greater than zero to avoid undesireable self-inflicted wounds:
+            if ( source ) {
+                Tank& tank = registry->getTank();
+                if ( (source->getType() != TANK || source->getShot().getDistance())
+                     && tank.getRect().contains(centerOfSquare) ) {
+                    switch( *angle ) {
+                    case  90:
+                    case 270:
+                        if ( hitPoint ) {
+                            hitPoint->setX( tank.getViewX().toInt()+24/2 );
+                            centerToEntryPoint( *angle, hitPoint );
+                        }
+                        break;
+                    case   0:
+                    case 180:
+                        if ( hitPoint ) {
+                            hitPoint->setY( tank.getViewY().toInt()+24/2 );
+                            centerToEntryPoint( *angle, hitPoint );
+                        }
+                        break;
+                    }
+                    if ( apply ) {
+                        source->getShot().setIsKill();
+                    }
+                    return false;
+                }
+            }
+        }
     }
-    return false;
+    return true;
 }
 
 void Game::onTankPushingInto( const ModelPoint& point, int fromAngle )
@@ -589,7 +685,7 @@ void Game::onTankPushingInto( const ModelPoint& point, int fromAngle )
         if ( getAdjacentPosition( fromAngle, &toPoint ) ) {
             SimplePiece simple( what );
             pm.eraseAt( point );
-            if ( GameRegistry* registry = getRegistry(this) ) {
+            if ( GameRegistry* registry = mRegistry ) {
                 registry->getTankPush().start( simple, point, toPoint );
             }
         } else {
@@ -602,20 +698,28 @@ void Game::onTankPushingInto( const ModelPoint& point, int fromAngle )
 
 void Game::onFuturePush( Piece* pushPiece, int direction )
 {
+    // copy what's needed since changing the future board invalidates the piece
+    ModelPoint fromPoint = *pushPiece;
+    PieceType type = pushPiece->getType();
+    int angle = pushPiece->getAngle();
+
     mFutureDelta.enable();
 
-    ModelPoint point = *pushPiece;
+    ModelPoint point = fromPoint;
     if ( !getAdjacentPosition( direction, &point ) ) {
         std::cout << "*** failed to get future pushPiece position for " << direction << "/" << point.mCol << "," << point.mRow << std::endl;
         return;
     }
-    mFutureBoard.applyPushResult( pushPiece->getType(), point, pushPiece->getAngle() );
-    if ( !mFutureBoard.getPieceManager().erase( pushPiece ) ) {
+    mFutureBoard.applyPushResult( type, point, angle );
+    if ( !mFutureBoard.getPieceManager().eraseAt( fromPoint ) ) {
         std::cout << "*** failed to erase future pushPiece at " << point.mCol << "," << point.mRow << std::endl;
     }
+    if ( type == TILE && mFutureBoard.isDeadSquare( point ) ) {
+        emit tileStranded( point, true );
+    }
 }
 
-const PieceSet* Game::getDeltaPieces()
+const PieceVector* Game::getDeltaPieces()
 {
     if ( mFutureDelta.enabled() ) {
         return &mFutureDelta.getPieceManager().getPieces();
@@ -626,7 +730,7 @@ const PieceSet* Game::getDeltaPieces()
 void Game::loadMasterBoard( int level )
 {
     emit mBoard.boardLoading( level );
-    if ( GameRegistry* registry = getRegistry(this) ) {
+    if ( GameRegistry* registry = mRegistry ) {
         if ( Board* board = registry->getBoardPool().getBoard( level ) ) {
             mBoard.load( board );
         }
@@ -640,7 +744,7 @@ void Game::undoFuturePush( MovePiece* pusher )
 
 void Game::onTankKilled()
 {
-    if ( GameRegistry* registry = getRegistry(this) ) {
+    if ( GameRegistry* registry = mRegistry ) {
         registry->getRecorder().dump();
 
         // if we don't have a window then we're headless (i.e. testing); don't show message boxes for the headless case
@@ -671,7 +775,7 @@ void Game::onTankKilled()
 void Game::restartLevel( bool replay )
 {
     if ( int level = mBoard.getLevel() ) {
-        if ( GameRegistry* registry = getRegistry(this) ) {
+        if ( GameRegistry* registry = mRegistry ) {
             registry->getMoveController().setReplay( replay );
             if ( Board* board = registry->getBoardPool().find( level ) ) {
                 mBoard.load( board );
@@ -685,6 +789,19 @@ void Game::restartLevel( bool replay )
 }
 
 void Game::replayLevel()
+{
+    if ( GameRegistry* registry = mRegistry ) {
+        registry->getSpeedController().getClock().setTurbo( false );
+    }
+    restartLevel( true );
+}
+
+void Game::turboReplayLevel()
 {
     restartLevel( true );
+    if ( GameRegistry* registry = mRegistry ) {
+        if ( registry->getMoveController().replaying() ) {
+            registry->getSpeedController().getClock().setTurbo( true );
+        }
+    }
 }
@@ -22,7 +22,13 @@ class Game : public QObject
 public:
     Game();
     ~Game() override = default;
-    void init( GameRegistry* registry );
+
+    /**
+     * @brief Wire the game up to the registry's components
+     * @param registry The registry holding this game
+     * @param clocked If false, the game clock isn't installed; for games which only plan moves and never animate them
+     */
+    void init( GameRegistry* registry, bool clocked = true );
 
     /**
      * @brief Get the current board
@@ -42,7 +48,8 @@ public:
      * @param angle The direction to move in. Must be one of 0, 90, 180 or 270
      * @param point The Piece's originating position as input. Returns the resultant position
      * @param futuristic If true, all outstanding moves are considered, otherwise only the current board state is considered
-     * @param pushPiece if non-null, returns a reference to any piece that this move would push
+     * @param pushPiece if non-null, returns a reference to any piece that this move would push. It is only valid until
+     * the board is next changed (see PieceSetManager::pieceAt)
      * @return true if the move is allowed, otherwise false
      */
     bool canMoveFrom( PieceType what, int angle, ModelPoint *point, bool futuristic, Piece **pushPiece = nullptr );
@@ -65,7 +72,8 @@ public:
      * @param what The type of piece
      * @param point The square to consider
      * @param fromAngle The entry direction
-     * @param pushPiece if non-null, returns a reference to any piece that this placement would result in pushing
+     * @param pushPiece if non-null, returns a reference to any piece that this placement would result in pushing. It is
+     * only valid until the board is next changed (see PieceSetManager::pieceAt)
      * @param futuristic If true, all outstanding moves are considered, otherwise only the current board state is considered
      * @return true if the placement is a legal move
      */
@@ -92,12 +100,40 @@ public:
      */
     static bool canPushPiece( const Piece* piece, int fromAngle );
 
+    /**
+     * @brief Determines whether the given piece can occupy the given square of a board snapshot. Safe in any thread.
+     * @param what The type of piece
+     * @param point The square to consider
+     * @param snapshot The board state to consider
+     * @return true if the square is vacant for the piece
+     */
+    static bool canPlaceAt( PieceType what, const ModelPoint& point, const BoardSnapshot& snapshot );
+
+    /**
+     * @brief Determines the outcome of a laser shot through the given square of a board snapshot without affecting
+     * any state. Safe in any thread. Moving pieces (pushes, the tank) are not considered.
+     * @param snapshot The board state to consider
+     * @param point The square of the lazer end point
+     * @param angle Inputs the laser direction as it enters the square; outputs the direction the laser exits the square
+     * @return true if the the shot is continuing to advance past the square or false if the shot hit something
+     */
+    static bool canShootThru( const BoardSnapshot& snapshot, const ModelPoint& point, int *angle );
+
+    /**
+     * @brief Look for a cannon with line of sight to the given square
+     * @param board The board to consider
+     * @param point The square of interest (i.e. the tank's)
+     * @param cannon If non-null and a cannon is found, returns the cannon's square and firing direction
+     * @return true if a cannon can shoot into the square
+     */
+    bool findSightingCannon( Board* board, const ModelPoint& point, ModelVector* cannon = nullptr );
+
     /**
      * @brief Obtain the set of pieces representing differences between the current board and
      * what the board will be as a result of applying outstanding moves
      * @return set of future pieces or 0 if future tracking is not active
      */
-    const PieceSet* getDeltaPieces();
+    const PieceVector* getDeltaPieces();
 
     void loadMasterBoard( int level );
 
@@ -131,10 +167,10 @@ public slots:
     void onBoardLoaded( int level );
 
     /**
-     * @brief Receives notification that a tile on the board changed.
-     * @param point The square where the change occurred
+     * @brief Receives notification of changes committed to the board
+     * @param changes The coalesced changes
      */
-    void onBoardTileChanged( const ModelPoint& point );
+    void onBoardChanged( const BoardChangeSet& changes );
 
     /**
      * @brief Recieves notification that a push has completed
@@ -175,12 +211,25 @@ public slots:
      */
     void replayLevel();
 
+    /**
+     * @brief Automate a replay of the current level which skips ahead as fast as possible. The board is rendered
+     * at the clock's frame rate and the replay can be stopped at any point like a normal replay.
+     */
+    void turboReplayLevel();
+
 signals:
     /**
      * @brief Emitted after the board is loaded and interested game objects have updated
      */
     void boardLoaded();
 
+    /**
+     * @brief Emitted when a tile is pushed on to a square from which it can never reach water (see Board::isDeadSquare)
+     * @param point The square the tile was pushed to
+     * @param futuristic true if the push is planned (i.e. on the future board), false if it happened
+     */
+    void tileStranded( const ModelPoint& point, bool futuristic );
+
 private:
     /**
      * @brief Determines whether the given single move is legal
@@ -212,6 +261,15 @@ private:
      */
     bool canCannonSightThru( Board* board, ModelPoint point );
 
+    /**
+     * @brief Determines the outcome of a laser shot through a square which can hold pieces. See canShootThru.
+     * @param board The board the shot is on
+     */
+    bool canShootThruPiece( Board* board, const ModelPoint& point, int *angle, FutureChange *change, bool apply,
+                            Shooter* source, QPoint *hitPoint );
+
+    // the context this game was initialized with. Kept rather than looked up so rule checks stay cheap
+    GameRegistry* mRegistry;
     Board mBoard;
     int mDesiredLevel;
 
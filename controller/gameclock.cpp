@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <iostream>
+
+#include "gameclock.h"
+#include "animationstateaggregator.h"
+
+constexpr int GameClock::TickInterval;
+constexpr int GameClock::DefaultFrameRate;
+constexpr int GameClock::DefaultFrameBudget;
+constexpr qreal GameClock::MinRate;
+constexpr qreal GameClock::MaxRate;
+constexpr qreal GameClock::FrameSkipRate;
+
+// limit on the rounds of queued events delivered per tick while nothing is animating
+constexpr int MaxPumpRounds = 8;
+
+// wall milliseconds over which the achieved tick rate is measured
+constexpr int MeasurePeriod = 1000;
+
+// the clock installed as the animation driver of each thread. Qt keeps a single driver per thread
+static thread_local GameClock* sInstalledClock = nullptr;
+
+GameClock::GameClock( QObject* parent ) : QAnimationDriver(parent), mFrameBudget{DefaultFrameBudget}, mElapsed{0},
+  mLastFrameTime{0}, mOwed{0}, mRate{1}, mTurbo{false}, mManual{false}, mInstalled{false}, mAdvancing{false},
+  mFinishedPending{false}, mMeasuredWall{0}, mMeasuredTicked{0}, mAchievedTickRate{0}
+{
+    mFrameTimer.setTimerType( Qt::PreciseTimer );
+    mFrameTimer.setInterval( 1000 / DefaultFrameRate );
+    QObject::connect( &mFrameTimer, &QTimer::timeout, this, &GameClock::onFrame );
+    mWallClock.start();
+}
+
+GameClock::~GameClock()
+{
+    if ( mInstalled ) {
+        uninstall();
+        sInstalledClock = nullptr;
+    }
+}
+
+void GameClock::activate()
+{
+    if ( !mInstalled ) {
+        if ( sInstalledClock ) {
+            std::cout << "** GameClock: another clock already drives this thread's animations" << std::endl;
+            return;
+        }
+        sInstalledClock = this;
+        mInstalled = true;
+        install();
+        scheduleFrames();
+    }
+}
+
+void GameClock::addAggregator( AnimationStateAggregator* aggregator )
+{
+    if ( std::find( mAggregators.begin(), mAggregators.end(), aggregator ) == mAggregators.end() ) {
+        mAggregators.push_back( aggregator );
+        aggregator->setClock( this );
+    }
+}
+
+void GameClock::scheduleFinished()
+{
+    bool wasPending = mFinishedPending;
+    mFinishedPending = true;
+    if ( mInstalled ) {
+        scheduleFrames();
+    } else if ( !wasPending ) {
+        // Not driving the animations so there's no tick to deliver after. Deliver from the event loop rather than
+        // from within the aggregator's state change, which can start the next move
+        QMetaObject::invokeMethod( this, "deliverFinished", Qt::QueuedConnection );
+    }
+}
+
+void GameClock::setFrameRate( int fps )
+{
+    mFrameTimer.setInterval( 1000 / std::max( fps, 1 ) );
+}
+
+void GameClock::setFrameBudget( int msecs )
+{
+    mFrameBudget = std::max( msecs, 1 );
+}
+
+bool GameClock::getTurbo() const
+{
+    return mTurbo;
+}
+
+qreal GameClock::getRate() const
+{
+    return mRate;
+}
+
+bool GameClock::getManual() const
+{
+    return mManual;
+}
+
+int GameClock::getRequestedTickRate() const
+{
+    return mTurbo ? 0 : static_cast<int>( mRate * 1000 / TickInterval );
+}
+
+int GameClock::getAchievedTickRate() const
+{
+    return mAchievedTickRate;
+}
+
+qint64 GameClock::elapsed() const
+{
+    return isRunning() ? mElapsed : 0;
+}
+
+void GameClock::setTurbo( bool on )
+{
+    if ( on != mTurbo ) {
+        mTurbo = on;
+        activate();
+        scheduleFrames();
+        emit turboChanged( on );
+    }
+}
+
+void GameClock::setRate( qreal rate )
+{
+    rate = std::min( std::max( rate, MinRate ), MaxRate );
+    if ( rate != mRate ) {
+        mRate = rate;
+        activate();
+    }
+}
+
+void GameClock::setManual( bool on )
+{
+    mManual = on;
+    if ( on ) {
+        mFrameTimer.stop();
+    } else {
+        scheduleFrames();
+    }
+}
+
+void GameClock::step( int msecs )
+{
+    activate();
+    if ( !mInstalled ) {
+        return;
+    }
+    pump();
+    for( int remaining = msecs; remaining > 0; remaining -= TickInterval ) {
+        if ( isRunning() ) {
+            tick( std::min( remaining, TickInterval ) );
+        }
+        pump();
+    }
+}
+
+void GameClock::start()
+{
+    // the unified animation timer rebases on this driver's elapsed time each time it starts it
+    mElapsed = 0;
+    QAnimationDriver::start();
+    scheduleFrames();
+}
+
+void GameClock::scheduleFrames()
+{
+    if ( mInstalled && !mManual && !mFrameTimer.isActive() ) {
+        mLastFrameTime = mWallClock.elapsed();
+        mFrameTimer.start();
+    }
+}
+
+void GameClock::tick( int msecs )
+{
+    mAdvancing = true;
+    mElapsed += msecs;
+    mMeasuredTicked += msecs;
+    advance();
+    mAdvancing = false;
+}
+
+void GameClock::deliverFinished()
+{
+    if ( mFinishedPending ) {
+        mFinishedPending = false;
+        if ( mTurbo ) {
+            // a skipped animation's step
+            mMeasuredTicked += TickInterval;
+        }
+        for( auto aggregator : mAggregators ) {
+            aggregator->deliverFinished();
+        }
+    }
+}
+
+void GameClock::pump()
+{
+    // deliver the aggregators' notifications raised by the tick. These and the ticked notification can start new
+    // animations (e.g. the next move) so keep delivering while nothing is animating. Other queued events are left to
+    // the event loop
+    for( int round = 0; round < MaxPumpRounds; ++round ) {
+        deliverFinished();
+        emit ticked();
+        if ( isRunning() && !mFinishedPending ) {
+            break;
+        }
+    }
+}
+
+void GameClock::measure( qint64 wallDelta )
+{
+    mMeasuredWall += wallDelta;
+    if ( mMeasuredWall >= MeasurePeriod ) {
+        mAchievedTickRate = static_cast<int>( mMeasuredTicked * 1000 / (mMeasuredWall * TickInterval) );
+        mMeasuredWall = mMeasuredTicked = 0;
+        emit tickRateMeasured( mAchievedTickRate, getRequestedTickRate() );
+    }
+}
+
+void GameClock::onFrame()
+{
+    // ignore frames from a nested event loop raised within the animations (e.g. a modal dialog)
+    if ( mAdvancing ) {
+        return;
+    }
+
+    qint64 frameStart = mWallClock.elapsed();
+    qint64 wallDelta = frameStart - mLastFrameTime;
+    mLastFrameTime = frameStart;
+
+    if ( mTurbo ) {
+        // Skipped animations finish as they start so most moves take no tick. Keep delivering for the frame's budget,
+        // ticking only while something (i.e. a shot) still animates
+        measure( wallDelta );
+        do {
+            if ( isRunning() ) {
+                tick( TickInterval );
+            }
+            pump();
+        } while( mTurbo && !mManual && (isRunning() || mFinishedPending)
+              && mWallClock.elapsed() - frameStart < mFrameBudget );
+    } else if ( !isRunning() ) {
+        // nothing animating; only the time spent animating counts towards the measurement
+        mOwed = 0;
+        pump();
+    } else {
+        measure( wallDelta );
+        mOwed += wallDelta * mRate;
+        if ( mRate <= FrameSkipRate ) {
+            // one step per painted frame
+            int step = static_cast<int>( mOwed );
+            if ( step > 0 ) {
+                mOwed -= step;
+                tick( step );
+            }
+            pump();
+        } else {
+            // skip painting the intermediate frames by taking whole ticks until caught up
+            while( mOwed >= TickInterval && !mManual && isRunning()
+                && mWallClock.elapsed() - frameStart < mFrameBudget ) {
+                mOwed -= TickInterval;
+                tick( TickInterval );
+                pump();
+            }
+            // drop whatever the budget couldn't cover rather than building a backlog
+            mOwed = std::min( mOwed, static_cast<qreal>(TickInterval) );
+        }
+    }
+
+    // idle until the animations restart
+    if ( !mTurbo && !isRunning() && !mFinishedPending ) {
+        mFrameTimer.stop();
+    }
+}
@@ -0,0 +1,179 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <vector>
+#include <QAnimationDriver>
+#include <QElapsedTimer>
+#include <QTimer>
+
+class AnimationStateAggregator;
+
+/**
+ * @brief The game's single animation timer.
+ * Once activated, every QAbstractAnimation in the app thread is advanced by this clock from one frame timer. The
+ * clock runs at a multiple of wall time, as fast as possible in turbo mode, or only when stepped in manual mode.
+ * Turbo mode skips the speed controlled animations (tank and push) outright, so each frame mostly delivers the
+ * notifications of moves which finished as they started; only the shots are still ticked.
+ * Each tick advances the animations then delivers the finished notifications of the registered aggregators in the
+ * order they were registered, followed by the ticked notification. Other queued events are left to the event loop.
+ * Qt has one animation driver per thread, so only one clock per thread can be activated. Above FrameSkipRate, each frame
+ * takes as many ticks as needed to keep pace and the board is only painted between frames.
+ */
+class GameClock : public QAnimationDriver
+{
+    Q_OBJECT
+
+public:
+    // virtual milliseconds per tick. Matches the interval of Qt's own animation timer so outcomes match normal play
+    static constexpr int TickInterval = 16;
+
+    static constexpr int DefaultFrameRate   = 60;
+    static constexpr int DefaultFrameBudget = 12; // milliseconds of each frame spent ticking
+
+    // supported range of rates relative to wall time
+    static constexpr qreal MinRate = 0.25;
+    static constexpr qreal MaxRate = 64;
+
+    // rate above which intermediate frames are skipped
+    static constexpr qreal FrameSkipRate = 2;
+
+    explicit GameClock( QObject* parent = nullptr );
+    ~GameClock() override;
+
+    /**
+     * @brief Take over driving the app thread's animations from Qt's default timer
+     * Does nothing if another clock already drives this thread's animations. An inactive clock delivers its
+     * aggregators' notifications from the event loop.
+     */
+    void activate();
+
+    /**
+     * @brief Register an aggregator whose finished notifications are to be delivered by this clock
+     * Notifications are delivered after the tick that finished the aggregator, in the order registered
+     */
+    void addAggregator( AnimationStateAggregator* aggregator );
+
+    /**
+     * @brief Request delivery of pending aggregator notifications. Called by registered aggregators.
+     */
+    void scheduleFinished();
+
+    /**
+     * @brief Set the number of frames rendered per second
+     */
+    void setFrameRate( int fps );
+
+    /**
+     * @brief Set how many milliseconds of each frame may be spent ticking the clock
+     */
+    void setFrameBudget( int msecs );
+
+    /**
+     * @brief Query whether the clock runs as fast as possible
+     */
+    bool getTurbo() const;
+
+    /**
+     * @brief Get the rate the clock runs at relative to wall time when not in turbo mode
+     */
+    qreal getRate() const;
+
+    /**
+     * @brief Query whether the clock only advances when stepped
+     */
+    bool getManual() const;
+
+    /**
+     * @brief Get the number of ticks per second the clock is asked to take
+     * @return The rate in ticks per second or 0 if unbounded (i.e. turbo mode)
+     */
+    int getRequestedTickRate() const;
+
+    /**
+     * @brief Get the number of ticks per second the clock took over the last measurement period
+     * In turbo mode each delivery of finished notifications counts as a tick since the skipped animations take none.
+     */
+    int getAchievedTickRate() const;
+
+    /**
+     * @brief Get the virtual time elapsed since the animations were last started
+     */
+    qint64 elapsed() const override;
+
+public slots:
+    /**
+     * @brief Start or stop driving the game as fast as possible
+     * @param on If true, speed controlled animations are skipped and the rest advance as fast as the frame budget
+     * allows, otherwise they revert to the rate
+     */
+    void setTurbo( bool on );
+
+    /**
+     * @brief Set the rate the clock runs at relative to wall time
+     * @param rate The multiplier. Clamped to MinRate..MaxRate.
+     */
+    void setRate( qreal rate );
+
+    /**
+     * @brief Stop or resume advancing with wall time. While manual, the clock only advances via step.
+     */
+    void setManual( bool on );
+
+    /**
+     * @brief Advance the clock by the given virtual time in ticks, delivering the notifications each tick raises
+     * @param msecs The virtual milliseconds to advance
+     */
+    void step( int msecs );
+
+signals:
+    /**
+     * @brief Notifies that the clock ticked and the events it raised were delivered
+     */
+    void ticked();
+
+    /**
+     * @brief Notifies when turbo mode starts/stops
+     */
+    void turboChanged( bool on );
+
+    /**
+     * @brief Notifies the tick rate achieved over the last measurement period
+     * @param achieved The ticks per second actually taken
+     * @param requested The ticks per second asked for or 0 if unbounded
+     */
+    void tickRateMeasured( int achieved, int requested );
+
+protected:
+    void start() override;
+
+private slots:
+    void onFrame();
+    void deliverFinished();
+
+private:
+    void scheduleFrames();
+    void tick( int msecs );
+    void pump();
+    void measure( qint64 wallDelta );
+
+    QTimer mFrameTimer;
+    QElapsedTimer mWallClock;
+    std::vector<AnimationStateAggregator*> mAggregators;
+    int mFrameBudget;
+    qint64 mElapsed;
+    qint64 mLastFrameTime;
+    qreal mOwed; // virtual milliseconds due but not yet ticked
+    qreal mRate;
+    bool mTurbo;
+    bool mManual;
+    bool mInstalled;
+    bool mAdvancing;
+    bool mFinishedPending;
+
+    // tick rate measurement
+    qint64 mMeasuredWall;
+    qint64 mMeasuredTicked;
+    int mAchievedTickRate;
+};
+
+#endif // GAMECLOCK_H
@@ -10,6 +10,7 @@
 #include "model/tank.h"
 #include "view/shooter.h"
 #include "view/levelchooser.h"
+#include "view/thumbnailcache.h"
 #include "model/push.h"
 #include "util/workerthread.h"
 #include "util/recorder.h"
@@ -31,13 +32,15 @@ GameRegistry::GameRegistry( BoardWindow* window ) : QObject(nullptr), mWindow(wi
   DECL_NULL_INIT(LevelList)
   DECL_NULL_INIT(Recorder)
   DECL_NULL_INIT(Persist)
+  DECL_NULL_INIT(ThumbnailCache)
+  DECL_NULL_INIT(CaptureAction)
+  DECL_NULL_INIT(PathToAction)
+  DECL_NULL_INIT(WorkerPool)
 {
     mHandle.registry = this;
     setProperty( GameHandleName, QVariant::fromValue(mHandle) );
 
-    mCaptureAction.setParent(this);
-    mPathToAction.setParent(this);
-    mPathToAction.setText( "Move &Here" );
+    mWorker.setStats( &mPerfStats );
 
     if ( window ) {
         QObject::connect( window, &BoardWindow::destroyed, this, &GameRegistry::onWindowDestroyed, Qt::DirectConnection );
@@ -78,12 +81,56 @@ DECL_GETTER(ShotPush,Push)
 DECL_GETTER(LevelList,LevelList)
 DECL_GETTER(Recorder,Recorder)
 DECL_GETTER(Persist,Persist)
+DECL_GETTER(ThumbnailCache,ThumbnailCache)
+
+DECL_GETTER(CaptureAction,PathSearchAction)
+
+PathSearchAction& GameRegistry::getPathToAction()
+{
+    if ( !mPathToAction ) {
+        mPathToAction = new PathSearchAction( this );
+        mPathToAction->setText( "Move &Here" );
+    }
+    return *mPathToAction;
+}
+
+WorkerPool& GameRegistry::getWorkerPool()
+{
+    if ( !mWorkerPool ) {
+        mWorkerPool = new WorkerPool();
+        mWorkerPool->setStats( &mPerfStats );
+    }
+    return *mWorkerPool;
+}
+
+void GameRegistry::deleteComponents()
+{
+#define DECL_CLEAN(name) { if ( m##name != nullptr ) { delete m##name; m##name=nullptr; } }
+    DECL_CLEAN(Game)
+    DECL_CLEAN(SpeedController)
+    DECL_CLEAN(MoveController)
+    DECL_CLEAN(PathFinderController)
+    DECL_CLEAN(MoveAggregate)
+    DECL_CLEAN(ShotAggregate)
+    DECL_CLEAN(BoardPool)
+    DECL_CLEAN(Tank)
+    DECL_CLEAN(ActiveCannon)
+    DECL_CLEAN(TankPush)
+    DECL_CLEAN(ShotPush)
+    DECL_CLEAN(LevelList)
+    DECL_CLEAN(Recorder)
+    DECL_CLEAN(Persist)
+    DECL_CLEAN(ThumbnailCache)
+}
 
 WorkerThread&     GameRegistry::getWorker()        { return mWorker;        }
-PathSearchAction& GameRegistry::getCaptureAction() { return mCaptureAction; }
-PathSearchAction& GameRegistry::getPathToAction()  { return mPathToAction;  }
+PerfStats&        GameRegistry::getPerfStats()     { return mPerfStats;     }
 
 GameRegistry::~GameRegistry()
 {
     mWorker.shutdown();
+    if ( mWorkerPool ) {
+        mWorkerPool->shutdown();
+        delete mWorkerPool;
+    }
 }
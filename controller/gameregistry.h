@@ -5,6 +5,7 @@
 #include "pathsearchaction.h"
 #include "util/gameutils.h"
 #include "util/workerthread.h"
+#include "util/perfstats.h"
 
 struct GameHandle;
 class Game;
@@ -21,6 +22,7 @@ class ShotModel;
 class Push;
 class Recorder;
 class Persist;
+class ThumbnailCache;
 
 class GameRegistry : public QObject
 {
@@ -114,11 +116,27 @@ public:
      */
     Persist& getPersist();
 
+    /**
+     * @brief Get the level chooser's thumbnail cache
+     */
+    ThumbnailCache& getThumbnailCache();
+
     /**
      * @brief Access to the background thread
      */
     WorkerThread& getWorker();
 
+    /**
+     * @brief Access to the background threads used for independent tasks that may run concurrently
+     * The pool is created on first use.
+     */
+    WorkerPool& getWorkerPool();
+
+    /**
+     * @brief Access the performance counters
+     */
+    PerfStats& getPerfStats();
+
     /**
      * @brief Get the flag capture action container
      */
@@ -133,6 +151,12 @@ private slots:
     void onWindowDestroyed();
 
 protected:
+    /**
+     * @brief Delete the components created so far so that they are created afresh on next access
+     * Used by the test and benchmark registries to reset between runs.
+     */
+    void deleteComponents();
+
     GameHandle mHandle;
     BoardWindow* mWindow;
     Game* mGame;
@@ -149,10 +173,14 @@ protected:
     LevelList* mLevelList;
     Recorder* mRecorder;
     Persist* mPersist;
+    ThumbnailCache* mThumbnailCache;
+
+    PathSearchAction* mCaptureAction;
+    PathSearchAction* mPathToAction;
 
+    PerfStats mPerfStats;
     WorkerThread mWorker;
-    PathSearchAction mCaptureAction;
-    PathSearchAction mPathToAction;
+    WorkerPool* mWorkerPool;
 };
 
 #endif // GAMEREGISTRY_H
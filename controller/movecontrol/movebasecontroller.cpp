@@ -1,10 +1,12 @@
 #include <iostream>
+#include <vector>
 #include <QAbstractEventDispatcher>
 
 #include "../movecontroller.h"
 #include "../gameregistry.h"
 #include "../game.h"
 #include "../animationstateaggregator.h"
+#include "../speedcontroller.h"
 #include "../pathsearchaction.h"
 #include "../model/tank.h"
 #include "../model/shotmodel.h"
@@ -12,7 +14,7 @@
 #include "../model/board.h"
 
 
-MoveBaseController::MoveBaseController( QObject* parent ) : QObject(parent), mState{Idle}, mFocus{MOVE}
+MoveBaseController::MoveBaseController( QObject* parent ) : QObject(parent), mPlanBase{0}, mState{Idle}, mFocus{MOVE}
 {
 }
 
@@ -24,6 +26,8 @@ void MoveBaseController::init( GameRegistry* registry )
 
     QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance();
     QObject::connect( dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &MoveBaseController::wakeup, Qt::DirectConnection );
+    // the event loop doesn't block while the clock is fast-forwarding:
+    QObject::connect( &registry->getSpeedController().getClock(), &GameClock::ticked, this, &MoveBaseController::wakeup, Qt::DirectConnection );
 
     QObject::connect( &registry->getTank().getShot(), &ShotModel::shooterReleased,        this, &MoveController::wakeup, Qt::QueuedConnection );
     QObject::connect( &registry->getShotAggregate(), &AnimationStateAggregator::finished, this, &MoveController::wakeup, Qt::QueuedConnection );
@@ -35,6 +39,7 @@ void MoveBaseController::onBoardLoaded( Board& board )
 
     mFutureShots.reset();
     mMoves.reset();
+    resetCheckpoints();
 
     // transition unconditionally to prime the pump:
     mState = Idle;
@@ -55,9 +60,13 @@ void MoveBaseController::moveInternal( MoveListManager& moves, int direction )
     } else if ( GameRegistry* registry = getRegistry(this) ) {
         Piece* pushPiece = nullptr;
         if ( registry->getGame().canMoveFrom( TANK, vector.mAngle, &vector, true, &pushPiece ) ) {
-            appendMove( moves, vector, pushPiece );
             if ( pushPiece ) {
-                registry->getGame().onFuturePush( pushPiece, vector.mAngle );
+                // copy the board's piece since appending the move can change the board
+                PushedPiece pushed( pushPiece );
+                appendMove( moves, vector, &pushed );
+                registry->getGame().onFuturePush( &pushed, vector.mAngle );
+            } else {
+                appendMove( moves, vector );
             }
         }
     }
@@ -94,6 +103,7 @@ void MoveBaseController::fireInternal( MoveListManager& moves, int count )
             count = 1;
         }
 
+        takeCheckpoint( moves );
         MovePiece* move = moves.append( MOVE, moves.getInitialVector(), count );
         mFutureShots.updateShots( 0, move );
         return;
@@ -117,6 +127,11 @@ void MoveBaseController::undoLastMoveInternal( PieceListManager& moves )
             }
         }
         moves.eraseBack();
+
+        // the state ahead of the new last move is no longer final
+        if ( &moves == &mMoves ) {
+            mCheckpoints.erase( mCheckpoints.lower_bound( mPlanBase + moves.size() ), mCheckpoints.end() );
+        }
     }
 }
 
@@ -231,6 +246,8 @@ void MoveBaseController::wakeup()
             // nothing waiting on this move; advance to next move
             mFutureShots.removePath( move, false );
             mMoves.eraseFront();
+            ++mPlanBase;
+            mCheckpoints.erase( mCheckpoints.begin(), mCheckpoints.lower_bound( mPlanBase ) );
             transitionState( IdlingStage );
             move = mMoves.getFront();
         }
@@ -275,21 +292,255 @@ bool MoveBaseController::applyPathUsingCriteria( PieceListManager* path, PathSea
             std::cout << "*** applyPathUsingCriteria: registry error" << std::endl;
             return false;
         }
-        mMoves.reset( path );
+        if ( pathHasPush( path ) ) {
+            undoMoves();
+            setFocus( MOVE );
+            replayPath( mMoves, path );
+        } else {
+            mMoves.reset( path );
+            resetCheckpoints();
+        }
     } else {
         if ( !criteria->getStartPoint().equals( getBaseFocusVector() ) ) {
             std::cout << "* applyPathUsingCriteria: stale start point" << std::endl;
             return false;
         }
-        mMoves.replaceBack( MOVE );
-        mMoves.appendList( path->getList() );
+        if ( pathHasPush( path ) ) {
+            replayPath( mMoves, path );
+        } else {
+            mMoves.replaceBack( MOVE );
+            mMoves.appendList( path->getList() );
+        }
     }
     mMoves.replaceBack( MOVE_HIGHLIGHT );
     return true;
 }
 
+bool MoveBaseController::replayPath( MoveListManager& moves, PieceListManager* path )
+{
+    for( const auto& it : path->getList() ) {
+        Piece* lastMove = moves.getBack();
+        ModelVector vector = (lastMove ? *lastMove : moves.getInitialVector());
+        if ( !vector.ModelPoint::equals( it ) ) {
+            moveInternal( moves, -1 );
+            lastMove = moves.getBack();
+            if ( !lastMove || !lastMove->ModelPoint::equals( it ) ) {
+                std::cout << "* replayPath: blocked at " << it.getCol() << "," << it.getRow() << std::endl;
+                return false;
+            }
+        }
+        if ( it.getAngle() != (lastMove ? lastMove->getAngle() : vector.mAngle) ) {
+            moveInternal( moves, it.getAngle() );
+        }
+    }
+    return true;
+}
+
+bool MoveBaseController::pathHasPush( PieceListManager* path )
+{
+    for( const auto& it : path->getList() ) {
+        if ( it.hasPush() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// stepDirection result for squares which aren't adjacent
+constexpr int NotAdjacent = -2;
+
+/**
+ * @brief Determine the direction of the single step between two squares
+ * @return The direction, -1 if the squares are the same or NotAdjacent
+ */
+static int stepDirection( const ModelPoint& from, const ModelPoint& to )
+{
+    if ( from.equals( to ) ) {
+        return -1;
+    }
+    for( int direction = 0; direction < 360; direction += 90 ) {
+        ModelPoint adjacent( from );
+        if ( getAdjacentPosition( direction, &adjacent ) && adjacent.equals( to ) ) {
+            return direction;
+        }
+    }
+    return NotAdjacent;
+}
+
+bool MoveBaseController::replayMove( MoveListManager& moves, const Piece& move )
+{
+    Piece* lastMove = moves.getBack();
+    int direction = stepDirection( lastMove ? *lastMove : moves.getInitialVector(), move );
+    return direction != NotAdjacent && replayStep( moves, direction, move );
+}
+
+bool MoveBaseController::replayStep( MoveListManager& moves, int direction, const Piece& move )
+{
+    Piece* lastMove = moves.getBack();
+    ModelVector vector = (lastMove ? *lastMove : moves.getInitialVector());
+    if ( direction >= 0 ) {
+        // check first so that a blocked step doesn't leave the tank turned towards it
+        GameRegistry* registry = getRegistry(this);
+        ModelPoint to( vector );
+        if ( !registry || !registry->getGame().canMoveFrom( TANK, direction, &to, true ) ) {
+            return false;
+        }
+        if ( direction != vector.mAngle ) {
+            moveInternal( moves, direction );
+        }
+        moveInternal( moves, -1 );
+        lastMove = moves.getBack();
+        if ( !lastMove || !lastMove->ModelPoint::equals( to ) ) {
+            return false;
+        }
+        vector = *lastMove;
+    }
+    if ( move.getAngle() != vector.mAngle ) {
+        moveInternal( moves, move.getAngle() );
+    }
+    if ( int count = move.getShotCount() ) {
+        fireInternal( moves, count );
+    }
+    return true;
+}
+
+int MoveBaseController::insertMove( int index, const MovePiece& move )
+{
+    return editMoves( index, 0, PieceDeque( 1, move ) );
+}
+
+int MoveBaseController::eraseMove( int index )
+{
+    return editMoves( index, 1, PieceDeque() );
+}
+
+int MoveBaseController::replaceMove( int index, const MovePiece& move )
+{
+    return editMoves( index, 1, PieceDeque( 1, move ) );
+}
+
+int MoveBaseController::editMoves( int index, int eraseCount, const PieceDeque& insertions )
+{
+    // the first move can't be changed once the tank has started on it
+    int firstEditable = (mState == Idle) ? 0 : 1;
+    if ( index < firstEditable || eraseCount < 0 || index + eraseCount > mMoves.size() ) {
+        return -1;
+    }
+
+    GameRegistry* registry = getRegistry(this);
+    if ( !registry ) {
+        return -1;
+    }
+
+    // The plan as it should be after the edit. The given moves are made at their squares; the others are replayed as
+    // the steps they took from their original predecessors, so the moves following the edit carry on from wherever it
+    // leaves the tank
+    const PieceDeque& list = mMoves.getList();
+    PieceDeque plan;
+    std::vector<int> steps;
+    for( int i = 0; i < static_cast<int>( list.size() ); ++i ) {
+        if ( i == index ) {
+            plan.insert( plan.end(), insertions.begin(), insertions.end() );
+            steps.insert( steps.end(), insertions.size(), NotAdjacent );
+        }
+        if ( i < index || i >= index + eraseCount ) {
+            plan.push_back( list[i] );
+            steps.push_back( stepDirection( i ? list[i-1] : mMoves.getInitialVector(), list[i] ) );
+        }
+    }
+    if ( index == static_cast<int>( list.size() ) ) {
+        plan.insert( plan.end(), insertions.begin(), insertions.end() );
+        steps.insert( steps.end(), insertions.size(), NotAdjacent );
+    }
+
+    // coalesce the future board's change notifications
+    Game& game = registry->getGame();
+    Board* futureBoard = game.getBoard( true );
+    bool transacting = !game.isMasterBoard( futureBoard );
+    if ( transacting ) {
+        futureBoard->beginChanges();
+    }
+
+    // Re-simulate from the nearest checkpoint. Stop at the first move which can no longer be made rather than carry
+    // on from a square the rest of the plan wasn't made from
+    int dropped = 0;
+    for( int i = truncateMoves( index ); i < static_cast<int>( plan.size() ); ++i ) {
+        const MovePiece& move = plan[i];
+        if ( !(steps[i] == NotAdjacent ? replayMove( mMoves, move ) : replayStep( mMoves, steps[i], move )) ) {
+            dropped = static_cast<int>( plan.size() ) - i;
+            std::cout << "* editMoves: dropped " << dropped << " moves from " << move.getCol() << "," << move.getRow() << std::endl;
+            break;
+        }
+    }
+
+    if ( transacting ) {
+        futureBoard->commitChanges();
+    }
+
+    if ( mMoves.size() ) {
+        mMoves.replaceBack( mFocus == TANK ? MOVE : MOVE_HIGHLIGHT );
+        if ( mFocus == TANK && mMoves.size() > 1 ) {
+            mMoves.replaceFront( MOVE_HIGHLIGHT );
+        }
+    }
+    return dropped;
+}
+
+int MoveBaseController::truncateMoves( int index )
+{
+    int firstReplayable = (mState == Idle) ? 0 : 1;
+    GameRegistry* registry = getRegistry(this);
+    if ( registry && index < mMoves.size() && !registry->getGame().isMasterBoard( registry->getGame().getBoard( true ) ) ) {
+        auto checkpoint = mCheckpoints.upper_bound( mPlanBase + index );
+        if ( checkpoint != mCheckpoints.begin() ) {
+            --checkpoint;
+            int checkpointIndex = checkpoint->first - mPlanBase;
+
+            // use the checkpoint if replaying forward from it is less work than undoing back from the end
+            if ( checkpointIndex >= firstReplayable && index - checkpointIndex < mMoves.size() - index ) {
+                // Put the future board back as it was ahead of the checkpoint, then drop the moves beyond it without
+                // undoing their effects one at a time
+                if ( registry->getGame().getBoard( true )->restore( *checkpoint->second ) ) {
+                    mCheckpoints.erase( ++checkpoint, mCheckpoints.end() );
+                    while( mMoves.size() > checkpointIndex ) {
+                        mFutureShots.removePath( mMoves.getBack(), false );
+                        mMoves.eraseBack();
+                    }
+                    return checkpointIndex;
+                }
+                std::cout << "** truncateMoves: failed to restore checkpoint " << checkpointIndex << std::endl;
+            }
+        }
+    }
+
+    while( mMoves.size() > index ) {
+        undoLastMoveInternal( mMoves );
+    }
+    return mMoves.size();
+}
+
+void MoveBaseController::takeCheckpoint( MoveListManager& moves )
+{
+    if ( &moves == &mMoves ) {
+        int position = mPlanBase + moves.size();
+        auto next = mCheckpoints.upper_bound( position );
+        if ( next == mCheckpoints.begin() || position - (--next)->first >= MoveCheckpointInterval ) {
+            if ( GameRegistry* registry = getRegistry(this) ) {
+                mCheckpoints[position] = registry->getGame().getBoard( true )->getSnapshot();
+            }
+        }
+    }
+}
+
+void MoveBaseController::resetCheckpoints()
+{
+    mCheckpoints.clear();
+    mPlanBase = 0;
+}
+
 void MoveBaseController::appendMove( MoveListManager& moves, const ModelVector& vector, Piece* pushPiece )
 {
+    takeCheckpoint( moves );
     moves.replaceBack( MOVE ); // erase highlight
     moves.append( MOVE_HIGHLIGHT, vector, 0, pushPiece );
 }
@@ -331,6 +582,7 @@ void MoveBaseController::setFocus( PieceType what )
                     if ( !tank.getPoint().equals(*front) ) {
                         // This model is optimized - injecting a move for a proper visual:
                         mMoves.push_front( MOVE_HIGHLIGHT, tank.getVector() );
+                        --mPlanBase;
                         highlighted = true;
                     }
                 }
@@ -5,6 +5,7 @@
 #include "movecontroller.h"
 #include "gameregistry.h"
 #include "game.h"
+#include "speedcontroller.h"
 #include "model/tank.h"
 #include "view/boardrenderer.h"
 #include "view/boardwindow.h"
@@ -46,7 +47,11 @@ bool MoveController::setReplay( bool on )
             emit replayChanged( true );
         }
     } else if ( mReplayReader ) {
+        if ( GameRegistry* registry = getRegistry(this) ) {
+            registry->getSpeedController().getClock().setTurbo( false );
+        }
         mMoves.reset();
+        resetCheckpoints();
         disconnect( this, SLOT(replayPlayback()) );
         delete mReplayReader;
         mReplayReader = nullptr;
@@ -78,14 +83,14 @@ static QColor getTankShotColor( QObject* context )
     return { Qt::white }; // should never happen - return something 'attention-getting'
 }
 
-void MoveController::render( Piece* pos, const QRect* rect, BoardRenderer& renderer, QPainter* painter )
+void MoveController::render( const QRect* rect, BoardRenderer& renderer, QPainter* painter )
 {
     if ( !replaying() ) {
         // find the minimum shot path uid in the drag list:
         auto minDragUID = std::numeric_limits<int>::max();
         if ( getDragState() != Inactive ) {
-            for( auto it : mDragMoves.getList() ) {
-                if ( int uid = it->getShotPathUID() ) {
+            for( const auto& move : mDragMoves.getList() ) {
+                if ( int uid = move.getShotPathUID() ) {
                     minDragUID = uid;
                     break;
                 }
@@ -94,31 +99,29 @@ void MoveController::render( Piece* pos, const QRect* rect, BoardRenderer& rende
 
         QPen savePen = painter->pen();
 
-        if ( !mFutureShots.getPaths().empty() ) {
+        std::vector<const FutureShotPath*> paths;
+        mFutureShots.getPathsIn( *rect, paths );
+        if ( !paths.empty() ) {
             QPen pen( Qt::DashLine );
-            for( auto it : mFutureShots.getPaths() ) {
-                if ( rect->intersects( it.getBounds() ) ) {
-                    QColor color = (it.getUID() >= minDragUID) ? getTankShotColor(this) : QColor(Qt::blue);
+            for( auto path : paths ) {
+                if ( rect->intersects( path->getBounds() ) ) {
+                    QColor color = (path->getUID() >= minDragUID) ? getTankShotColor(this) : QColor(Qt::blue);
                     color.setAlpha(127); // dim it's color to contrast future shots from actual shots
                     pen.setColor( color );
                     pen.setWidth(2);
                     painter->setPen( pen );
-                    painter->drawPath( *it.toQPath() );
+                    painter->drawPath( *path->toQPath() );
                 }
             }
             painter->setPen( savePen );
         }
 
-        const PieceMultiSet* set = mMoves.toMultiSet();
-        auto it = set->lower_bound( pos );
         painter->setPen( Qt::blue );
-        renderer.renderListIn( it, set->end(), rect, painter );
+        renderer.renderListIn( *mMoves.toMultiSet(), rect, painter );
         painter->setPen( savePen );
 
         if ( getDragState() != Inactive && mDragMoves.size() ) {
-            const PieceMultiSet* set = mDragMoves.toMultiSet();
-            auto it = set->lower_bound( pos );
-            renderer.renderListIn( it, set->end(), rect, painter );
+            renderer.renderListIn( *mDragMoves.toMultiSet(), rect, painter );
         }
     }
 }
@@ -102,6 +102,14 @@ void MoveDragController::undoLastMove()
     }
 }
 
+int MoveDragController::editMoves( int index, int eraseCount, const PieceDeque& insertions )
+{
+    if ( mDragState != Inactive || mDragMoves.size() ) {
+        return -1;
+    }
+    return MoveBaseController::editMoves( index, eraseCount, insertions );
+}
+
 void MoveDragController::undoMoves()
 {
     while( mDragMoves.size() ) {
@@ -167,8 +175,8 @@ void MoveDragController::setDragState( DragState state )
             }
 
             if ( mDragMoves.size() ) {
-                for( auto it : mDragMoves.getList() ) {
-                    if ( int uid = it->getShotPathUID() ) {
+                for( const auto& move : mDragMoves.getList() ) {
+                    if ( int uid = move.getShotPathUID() ) {
                         for( const auto& fsit : mFutureShots.getPaths() ) {
                             if ( fsit.getUID() >= uid ) {
                                 mFutureShots.invalidate( fsit );
@@ -180,6 +188,7 @@ void MoveDragController::setDragState( DragState state )
 
                 if ( mFocus == TANK ) {
                     mMoves.reset( &mDragMoves, false );
+                    resetCheckpoints();
                     setFocus( MOVE );
                 } else {
                     mMoves.replaceBack( MOVE );
@@ -236,7 +245,14 @@ void MoveDragController::onPathFound( PieceListManager* path, PathSearchCriteria
             std::cout << "onPathFound: start " << criteria->getStartCol() << "," << criteria->getStartRow() << " != focus" << std::endl;
         }
 #endif // QT_NO_DEBUG
-        mDragMoves.reset( path );
+        if ( pathHasPush( path ) ) {
+            while( mDragMoves.size() ) {
+                undoLastMoveInternal( mDragMoves );
+            }
+            replayPath( mDragMoves, path );
+        } else {
+            mDragMoves.reset( path );
+        }
         mDragMoves.replaceBack( MOVE_HIGHLIGHT );
         if ( criteria->getCriteriaType() == PathSearchCriteria::TileDragTestCriteria ) {
             moveInternal( mDragMoves, mTileDragFocusAngle );
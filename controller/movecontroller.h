@@ -1,12 +1,15 @@
 #ifndef MOVECONTROLLER_H
 #define MOVECONTROLLER_H
 
+#include <map>
+#include <memory>
 #include <QObject>
 
 class GameRegistry;
 class Game;
 class FutureShotPathManager;
 class Board;
+class BoardSnapshot;
 class PathSearchAction;
 class BoardWindow;
 
@@ -16,6 +19,9 @@ class BoardWindow;
 #include "model/movelistmanager.h"
 #include "util/recorder.h"
 
+// The number of planned moves between future board checkpoints
+constexpr int MoveCheckpointInterval = 32;
+
 typedef enum {
     Idle,
     MovingStage,
@@ -59,6 +65,32 @@ public:
      */
     FutureShotPathManager& getFutureShots();
 
+    /**
+     * @brief Insert a move into the pending moves. The moves that follow are re-simulated as steps from it.
+     * @param index The position within the pending moves to insert at
+     * @param move The square, direction and shot count of the new move
+     * @return The number of moves dropped, from the first that can no longer be made to the end, or -1 if the edit is
+     * not allowed (e.g. the move is in progress)
+     */
+    int insertMove( int index, const MovePiece& move );
+
+    /**
+     * @brief Remove a move from the pending moves. The moves that follow are re-simulated as steps without it, up to
+     * the first that can no longer be made. It and the moves after it are dropped.
+     * @param index The position of the move within the pending moves
+     * @return The number of following moves dropped, or -1 if the edit is not allowed
+     */
+    int eraseMove( int index );
+
+    /**
+     * @brief Change a move within the pending moves. The moves that follow are re-simulated as steps from it.
+     * @param index The position of the move within the pending moves
+     * @param move The new square, direction and shot count for the move
+     * @return The number of moves dropped, from the first that can no longer be made to the end, or -1 if the edit is
+     * not allowed
+     */
+    int replaceMove( int index, const MovePiece& move );
+
     /**
      * @brief Returns whether movement should occur
      * @return true if paused otherwise false
@@ -125,6 +157,65 @@ protected:
      */
     bool applyPathUsingCriteria( PieceListManager* path, PathSearchCriteria* criteria );
 
+    /**
+     * @brief Replay a path one move at a time so that any pushes it makes are applied to the future board
+     * @param moves The managed list of moves to extend
+     * @param path The path to replay. Its first move must be adjacent to or at the end of the given moves
+     * @return true if the whole path was replayed
+     */
+    bool replayPath( MoveListManager& moves, PieceListManager* path );
+
+    /**
+     * @brief Query whether the given path pushes any pieces
+     */
+    static bool pathHasPush( PieceListManager* path );
+
+    /**
+     * @brief Apply a previously planned move to the end of the given moves, turning to face its square as needed
+     * @param moves The managed list of moves to extend
+     * @param move The move to make. Its square must be adjacent to or at the end of the given moves
+     * @return false if the move can no longer be made
+     */
+    bool replayMove( MoveListManager& moves, const Piece& move );
+
+    /**
+     * @brief Apply a previously planned move to the end of the given moves as the step it took from its predecessor
+     * @param moves The managed list of moves to extend
+     * @param direction The direction the move stepped in, or -1 if it stayed on its predecessor's square
+     * @param move The move. Its direction and shot count are applied after the step.
+     * @return false if the step can no longer be made, in which case the moves are left unchanged
+     */
+    bool replayStep( MoveListManager& moves, int direction, const Piece& move );
+
+    /**
+     * @brief Replace a range of the pending moves and re-simulate the moves which follow
+     * The insertions are made at their squares. Each following move is replayed as the step it took from its
+     * predecessor, so the rest of the plan carries on from wherever the edit leaves the tank. Replay stops at the
+     * first move which can no longer be made; it and the moves after it are dropped.
+     * @param index The position of the first move to replace
+     * @param eraseCount The number of moves to replace
+     * @param insertions The moves to put in their place
+     * @return The number of moves dropped, from the first that can no longer be made to the end, or -1 if the edit is
+     * not allowed
+     */
+    virtual int editMoves( int index, int eraseCount, const PieceDeque& insertions );
+
+    /**
+     * @brief Remove the pending moves from the given position onward, reverting their effects on the future board
+     * @return The number of moves kept, which may be fewer than requested when restored from a checkpoint
+     */
+    int truncateMoves( int index );
+
+    /**
+     * @brief Record the future board ahead of the move about to be added, if due
+     */
+    void takeCheckpoint( MoveListManager& moves );
+
+    /**
+     * @brief Forget the future board checkpoints; for when the pending moves are replaced wholesale
+     */
+    void resetCheckpoints();
+
     /**
      * @brief Add/modify move
      * @param moves The managed list of moves to update
@@ -171,6 +262,17 @@ protected:
      */
     FutureShotPathManager mFutureShots;
 
+    /**
+     * @brief Future board states keyed by plan position. The state at position n is that prior to the move at
+     * position n, where a move's plan position is its index in mMoves plus mPlanBase.
+     */
+    std::map<int,std::shared_ptr<const BoardSnapshot>> mCheckpoints;
+
+    /**
+     * @brief The plan position of the first element of mMoves. Increases as moves are completed.
+     */
+    int mPlanBase;
+
     MoveState mState;
     PieceType mFocus;
 };
@@ -314,6 +416,11 @@ protected slots:
     void onTestResult( bool reachable, PathSearchCriteria* criteria );
 
 protected:
+    /**
+     * @brief Refuses edits while dragging since the drag's moves are planned from the end of the pending moves
+     */
+    int editMoves( int index, int eraseCount, const PieceDeque& insertions ) override;
+
     MoveListManager mDragMoves;
 
 private:
@@ -350,7 +457,10 @@ public:
      */
     bool replaying() const;
 
-    void render( Piece* pos, const QRect* rect, BoardRenderer& renderer, QPainter* painter );
+    /**
+     * @brief Paint the planned moves and their future shots which lie within the given area
+     */
+    void render( const QRect* rect, BoardRenderer& renderer, QPainter* painter );
 
     void connectWindow( const BoardWindow* window ) const;
 
@@ -1,4 +1,5 @@
 #include <QVariant>
+#include <QElapsedTimer>
 
 #include "util/gameutils.h"
 #include "pathfinder.h"
@@ -6,14 +7,16 @@
 #include "controller/pathfindercontroller.h"
 #include "controller/gameregistry.h"
 #include "model/push.h"
+#include "util/trace.h"
 
 // search map values:
 #define TRAVERSIBLE 3
 #define BLOCKED     4
 #define TARGET      5
 
-PathFinder::PathFinder( QObject* parent ) : QObject(parent), mStopping{false}, mNPoints{}, mPassValue{}, mPushIndex{},
-    mPushDirection{}, mTestOnly{false}, mJmpBuf{}, mPathSearchRunnable(*this), mTileDragBuildRunnable(*this)
+PathFinder::PathFinder( QObject* parent ) : QObject(parent), mStopping{false}, mFrontier(BoardMaxWidth*BoardMaxHeight),
+    mPullIndex{}, mPushIndex{}, mPassValue{}, mTestOnly{false}, mPushPlanner(mRouteSearch), mStats{nullptr}, mJmpBuf{},
+    mPathSearchRunnable(*this), mTileDragBuildRunnable(*this)
 {
 }
 
@@ -21,39 +24,53 @@ bool PathFinder::execCriteria( PathSearchCriteria* criteria, bool testOnly )
 {
     mStopping = true;
 
-    // initialize the search map
-    // Note: Done here (in the app thread) to ensure the board doesn't change while reading it.
+    // Capture the board here (in the app thread). The search map is initialized from the snapshot in the background.
     if ( GameRegistry* registry = getRegistry(this) ) {
         Game& game = registry->getGame();
         Board* board = game.getBoard( true );
-        mMaxPoint = board->getLowerRight();
-
-        ModelPoint point;
-        for( point.mRow = mMaxPoint.mRow; point.mRow >= 0; --point.mRow ) {
-            for( point.mCol = mMaxPoint.mCol; point.mCol >= 0; --point.mCol ) {
-                mSearchMap[point.mRow*BoardMaxWidth+point.mCol] =
-                  game.canPlaceAt( TANK, point, -1, true ) ? TRAVERSIBLE : BLOCKED;
-            }
-        }
+        std::shared_ptr<const BoardSnapshot> snapshot = board->getSnapshot();
 
         // account for any outstanding pushes if this is on the master board
+        std::vector<ModelPoint> pushTargets;
         if ( game.isMasterBoard(board) ) {
-            addPush( registry->getTankPush() );
-            addPush( registry->getShotPush() );
+            addPush( registry->getTankPush(), pushTargets );
+            addPush( registry->getShotPush(), pushTargets );
         }
 
-        mCriteria = *criteria;
-        mTestOnly = testOnly;
+        {   std::lock_guard<std::mutex> guard( mCriteriaMutex );
+            mCriteria = *criteria;
+            mSnapshot = snapshot;
+            mPushTargets.swap( pushTargets );
+            mTestOnly = testOnly;
+        }
+        mStats = &registry->getPerfStats();
         registry->getWorker().doWork( &mPathSearchRunnable );
         return true;
     }
     return false;
 }
 
-void PathFinder::addPush( Push& push )
+void PathFinder::addPush( Push& push, std::vector<ModelPoint>& pushTargets )
 {
     if ( push.getType() != NONE ) {
-        mSearchMap[ push.getTargetPoint().mRow*BoardMaxWidth + push.getTargetPoint().mCol ] = BLOCKED;
+        pushTargets.push_back( push.getTargetPoint() );
+    }
+}
+
+void PathFinder::initSearchMap( const BoardSnapshot& snapshot, const std::vector<ModelPoint>& pushTargets )
+{
+    mMaxPoint = snapshot.getLowerRight();
+
+    ModelPoint point;
+    for( point.mRow = mMaxPoint.mRow; point.mRow >= 0; --point.mRow ) {
+        for( point.mCol = mMaxPoint.mCol; point.mCol >= 0; --point.mCol ) {
+            mSearchMap[point.mRow*BoardMaxWidth+point.mCol] =
+              Game::canPlaceAt( TANK, point, snapshot ) ? TRAVERSIBLE : BLOCKED;
+        }
+    }
+
+    for( auto target : pushTargets ) {
+        mSearchMap[target.mRow*BoardMaxWidth + target.mCol] = BLOCKED;
     }
 }
 
@@ -79,41 +96,27 @@ void PathFinder::printSearchMap()
 
 #define CANBUILD() mSearchMap[row*BoardMaxWidth+col]==mPassValue
 
-bool PathFinder::buildPath()
+void PathFinder::setCosts( int moveCost, int rotateCost )
 {
-    ModelVector curVector = mRunCriteria.getStartVector();
-
-    int angle = curVector.mAngle;
-    int col = curVector.mCol;
-    int row = curVector.mRow;
+    mRouteSearch.setCosts( moveCost, rotateCost );
+}
 
-    while( !mRunCriteria.getTargetPoint().equals( curVector ) ) {
-        if ( --mPassValue < 0 ) {
-            mPassValue = TRAVERSIBLE-1;
-        }
-        for( ;; ) {
-            switch( angle ) {
-            case   0: if ( row > 0              ) { --row; if ( CANBUILD() ) goto found; ++row; } break;
-            case 270: if ( col > 0              ) { --col; if ( CANBUILD() ) goto found; ++col; } break;
-            case 180: if ( row < mMaxPoint.mRow ) { ++row; if ( CANBUILD() ) goto found; --row; } break;
-            case  90: if ( col < mMaxPoint.mCol ) { ++col; if ( CANBUILD() ) goto found; --col; } break;
-            }
+bool PathFinder::searchPath()
+{
+    ModelVector start = mRunCriteria.getStartVector();
+    ModelPoint target = mRunCriteria.getTargetPoint();
+    if ( target.equals( start ) ) {
+        // not interested in 0-length paths
+        return false;
+    }
 
-            angle = (angle + 90) % 360;
-            if ( angle == curVector.mAngle ) {
-                return false;
-            }
-        }
-      found:
-        curVector.mAngle = angle;
-        if ( !curVector.equals( mRunCriteria.getStartVector() ) ) {
-            mMoves.append( MOVE, curVector );
-        }
-        curVector.mCol = col;
-        curVector.mRow = row;
+    std::vector<int> headings;
+    if ( mRouteSearch.search( start, target, mMaxPoint, [this]( int square ) { return mSearchMap[square] == TRAVERSIBLE; },
+                              mStopping, headings ) ) {
+        RouteSearch::appendMoves( start, headings, mMoves );
+        return true;
     }
-    mMoves.append( MOVE, curVector );
-    return true;
+    return false;
 }
 
 bool PathFinder::buildTilePushPath( const ModelVector& target )
@@ -197,11 +200,7 @@ bool PathFinder::tryAt( int col, int row )
 
         case TRAVERSIBLE:
             mSearchMap[row*BoardMaxWidth + col] = mPassValue;
-            if ( mPushIndex >= 0 && mPushIndex < (int) ((sizeof mSearchCol)/(sizeof *mSearchCol)) ) {
-                mSearchCol[mPushIndex] = col;
-                mSearchRow[mPushIndex] = row;
-                mPushIndex += mPushDirection;
-            }
+            mFrontier[mPushIndex++] = row*BoardMaxWidth + col;
             break;
 
         default:
@@ -211,15 +210,14 @@ bool PathFinder::tryAt( int col, int row )
     return false;
 }
 
-void PathFinder::pass1()
+void PathFinder::pass()
 {
+    // consume the points queued by the previous pass, marking their neighbors with the next pass value:
     mPassValue = (mPassValue + 1) % TRAVERSIBLE;
-    mPushIndex = (sizeof mSearchCol)/(sizeof *mSearchCol)-1;
-    mPushDirection = -1;
 
-    for( unsigned pullIndex = 0; pullIndex < mNPoints && !mStopping; ++pullIndex ) {
-        int col = mSearchCol[pullIndex];
-        int row = mSearchRow[pullIndex];
+    for( unsigned endIndex = mPushIndex; mPullIndex < endIndex && !mStopping; ++mPullIndex ) {
+        int col = mFrontier[mPullIndex] % BoardMaxWidth;
+        int row = mFrontier[mPullIndex] / BoardMaxWidth;
         if ( tryAt( col,   row-1 )
           || tryAt( col-1, row   )
           || tryAt( col,   row+1 )
@@ -227,53 +225,46 @@ void PathFinder::pass1()
             std::longjmp( mJmpBuf, 1 );
         }
     }
-    mNPoints = (sizeof mSearchCol)/(sizeof *mSearchCol) - mPushIndex;
-}
-
-void PathFinder::pass2()
-{
-    mPassValue = (mPassValue + 1) % TRAVERSIBLE;
-    mPushIndex = 0;
-    mPushDirection = 1;
-    int endIndex = (sizeof mSearchCol)/(sizeof *mSearchCol) - mNPoints;
-
-    for( int pullIndex = (sizeof mSearchCol)/(sizeof *mSearchCol); --pullIndex > endIndex && !mStopping; ) {
-        int col = mSearchCol[pullIndex];
-        int row = mSearchRow[pullIndex];
-        if ( tryAt( col,   row-1 )
-          || tryAt( col-1, row   )
-          || tryAt( col,   row+1 )
-          || tryAt( col+1, row   ) ) {
-            std::longjmp( mJmpBuf, 1 );
-        }
-    }
-    mNPoints = mPushIndex;
 }
 
 void PathFinder::doSearchInternal()
 {
+    TRACE_SCOPE( "PathFinder::doSearchInternal" );
     mStopping = false;
+    QElapsedTimer timer;
+    timer.start();
+    unsigned long routeExpanded = mRouteSearch.getExpandedCount();
+    int planned = 0;
 
     // copy the action for background thread use:
-    mRunCriteria = mCriteria;
+    std::shared_ptr<const BoardSnapshot> snapshot;
+    std::vector<ModelPoint> pushTargets;
+    bool testOnly;
+    {   std::lock_guard<std::mutex> guard( mCriteriaMutex );
+        mRunCriteria = mCriteria;
+        snapshot = mSnapshot;
+        pushTargets = mPushTargets;
+        testOnly = mTestOnly;
+    }
+    if ( !snapshot ) {
+        return;
+    }
+    initSearchMap( *snapshot, pushTargets );
+    bool pushing = !testOnly && mRunCriteria.getPushBudget() > 0;
+    if ( pushing ) {
+        mPushPlanner.init( *snapshot, pushTargets );
+    }
 
-    mNPoints = 0;
+    mPullIndex = 0;
     mPushIndex = 0;
-    mPushDirection = 1;
     mMoves.reset();
     mTargets.clear();
     bool found = false;
-    if ( !setjmp( mJmpBuf ) ) {
+    if ( mRunCriteria.getCriteriaType() == PathSearchCriteria::PathCriteria ) {
+        found = searchPath();
+    } else if ( !setjmp( mJmpBuf ) ) {
         mPassValue = 0;
         switch( mRunCriteria.getCriteriaType() ) {
-        case PathSearchCriteria::PathCriteria:
-            // For path search the starting point is targetted
-            mSearchMap[mRunCriteria.getStartRow() *BoardMaxWidth+mRunCriteria.getStartCol() ] = TARGET;
-            mTargets.insert( mRunCriteria.getStartVector() );
-            tryAt( mRunCriteria.getTargetCol(), mRunCriteria.getTargetRow() );
-            // Note we are not interested in 0-length paths in this case so we don't set found here
-            break;
-
         case PathSearchCriteria::TileDragTestCriteria:
             // for multi target test, the target points are targeted
             if ( TileDragTestResult* result = mRunCriteria.getTileDragTestResult() ) {
@@ -295,16 +286,28 @@ void PathFinder::doSearchInternal()
             ;
         }
 
-        mNPoints = mPushIndex;
-        while( mNPoints && !mStopping ) {
-            pass1();
-            pass2();
+        while( mPullIndex < mPushIndex && !mStopping ) {
+            pass();
         }
     } else {
         found = true;
     }
 
-    if ( mTestOnly ) {
+    // fall back to routing through pushes when there's no direct path. Tests only report direct reachability:
+    if ( !found && !mStopping && pushing
+      && mRunCriteria.getCriteriaType() == PathSearchCriteria::PathCriteria ) {
+        found = mPushPlanner.plan( mRunCriteria.getStartVector(), mRunCriteria.getTargetPoint(),
+                                   mRunCriteria.getPushBudget(), mMoves, mStopping );
+        planned = mPushPlanner.getNodeCount();
+    }
+
+    if ( mStats ) {
+        mStats->record( PerfStats::PathSearchTime, timer.nsecsElapsed() / 1000 );
+        mStats->record( PerfStats::PathSearchExpanded,
+                        static_cast<qint64>( mPullIndex + (mRouteSearch.getExpandedCount() - routeExpanded) ) + planned );
+    }
+
+    if ( testOnly ) {
         // At this point found is set when ALL are found. For the drag test, set found if ANY are found:
         if ( !found && mRunCriteria.getCriteriaType() == PathSearchCriteria::TileDragTestCriteria ) {
             if ( TileDragTestResult* result = mRunCriteria.getTileDragTestResult() ) {
@@ -312,10 +315,8 @@ void PathFinder::doSearchInternal()
             }
         }
         emit testResult( found, mRunCriteria );
-    } else if ( found ) {
-        if ( buildPath() ) {
-            emit pathFound( mRunCriteria, &mMoves );
-        }
+    } else if ( found && mMoves.size() ) {
+        emit pathFound( mRunCriteria, &mMoves );
     }
 }
 
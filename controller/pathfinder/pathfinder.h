@@ -2,19 +2,22 @@
 #define PATHFINDER_H
 
 #include <csetjmp>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 class Game;
 class Push;
 class PathFinder;
+class PerfStats;
 
 #include "model/board.h"
 #include "model/piecelistmanager.h"
 #include "pathsearchcriteria.h"
+#include "pushplanner.h"
+#include "routesearch.h"
 #include "util/workerthread.h"
 
-// The maximum number of points to track for a given search pass. (A pass can consider nearly two rows worth)
-constexpr int PathfinderMaxPoints = ((BoardMaxHeight>BoardMaxWidth) ? BoardMaxHeight : BoardMaxWidth) * 2;
-
 /**
  * @brief Computes a list of moves between two points for the current board.
  */
@@ -42,6 +45,13 @@ public:
      */
     bool buildTilePushPath( const ModelVector& target );
 
+    /**
+     * @brief Set how paths are ranked. Must be called in the app thread while no search is in progress.
+     * @param moveCost The cost of moving one square
+     * @param rotateCost The cost of rotating 90 degrees
+     */
+    void setCosts( int moveCost, int rotateCost );
+
 signals:
     /**
      * @brief Notification of successful computed path results
@@ -60,28 +70,36 @@ signals:
 private:
     void doSearchInternal();
     void buildTilePushPathInternal( const ModelVector& target );
-    void addPush( Push& push );
+    void addPush( Push& push, std::vector<ModelPoint>& pushTargets );
+    void initSearchMap( const BoardSnapshot& snapshot, const std::vector<ModelPoint>& pushTargets );
     bool tryAt( int col, int row );
-    void pass1();
-    void pass2();
-    bool buildPath();
+    void pass();
+    bool searchPath();
 
+    // the parameters of the most recent request, guarded by mCriteriaMutex:
+    std::mutex mCriteriaMutex;
     PathSearchCriteria mCriteria;
+    std::shared_ptr<const BoardSnapshot> mSnapshot;
+    std::vector<ModelPoint> mPushTargets;
+
     PathSearchCriteria mRunCriteria; // copy used by the background which won't be impacted by a parallel call to findPath
     bool mStopping;
     char mSearchMap[BoardMaxHeight*BoardMaxWidth];
     ModelPoint mMaxPoint;
-    int mSearchCol[PathfinderMaxPoints];
-    int mSearchRow[PathfinderMaxPoints];
-    unsigned mNPoints;
+    // Search order queue of square offsets into mSearchMap. A square is queued at most once per search so this never
+    // needs more than one entry per board square
+    std::vector<int> mFrontier;
+    unsigned mPullIndex;
+    unsigned mPushIndex;
     int mPassValue;
-    int mPushIndex;
-    int mPushDirection;
     bool mTestOnly;
     std::set<ModelPoint> mTargets;
 
     PieceListManager mMoves;
+    RouteSearch mRouteSearch;
+    PushPlanner mPushPlanner;
 
+    PerfStats* mStats;
     std::jmp_buf mJmpBuf;
 
     class PathSearchRunnable : public BasicRunnable
@@ -89,6 +107,8 @@ private:
     public:
         PathSearchRunnable( PathFinder& pathFinder ) : mPathFinder(pathFinder) {}
 
+        const char* getName() const override { return "PathSearchRunnable"; }
+
         void run() override;
 
         PathFinder& mPathFinder;
@@ -99,6 +119,8 @@ private:
     public:
         TileDragBuildRunnable( PathFinder& pathFinder ) : mPathFinder(pathFinder) {}
 
+        const char* getName() const override { return "TileDragBuildRunnable"; }
+
         void run() override
         {
             mPathFinder.buildTilePushPathInternal( mTarget );
@@ -62,6 +62,11 @@ bool PathFinderController::buildTilePushPath( const ModelVector& target )
     return mPathFinder.buildTilePushPath( target );
 }
 
+void PathFinderController::setPathCosts( int moveCost, int rotateCost )
+{
+    mPathFinder.setCosts( moveCost, rotateCost );
+}
+
 void PathFinderController::onResult( bool reachable, PathSearchCriteria criteria )
 {
     // filter any stale results
@@ -5,9 +5,9 @@ PathSearchAction::PathSearchAction( QObject*parent ) : QAction(parent)
 {
 }
 
-bool PathSearchAction::setCriteria( PieceType focus, const ModelPoint& target )
+bool PathSearchAction::setCriteria( PieceType focus, const ModelPoint& target, int pushBudget )
 {
-    return mCriteria.setPathCriteria( focus, target, this );
+    return mCriteria.setPathCriteria( focus, target, this, pushBudget );
 }
 
 PathSearchCriteria& PathSearchAction::getCriteria()
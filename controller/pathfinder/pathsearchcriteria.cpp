@@ -6,11 +6,12 @@
 #include "model/tank.h"
 #include "model/piece.h"
 
-PathSearchCriteria::PathSearchCriteria() : mCriteriaType{NullCriteria}, mFocus{MOVE}, mAction{nullptr}, mTileDragTestResult{nullptr}
+PathSearchCriteria::PathSearchCriteria() : mCriteriaType{NullCriteria}, mFocus{MOVE}, mAction{nullptr}, mTileDragTestResult{nullptr},
+  mPushBudget{0}
 {
 }
 
-bool PathSearchCriteria::setPathCriteria( PieceType focus, const ModelPoint& target, QAction* action )
+bool PathSearchCriteria::setPathCriteria( PieceType focus, const ModelPoint& target, QAction* action, int pushBudget )
 {
     if ( GameRegistry* registry = getRegistry(action) ) {
         mCriteriaType = PathCriteria;
@@ -18,6 +19,7 @@ bool PathSearchCriteria::setPathCriteria( PieceType focus, const ModelPoint& tar
         setFocusInternal( focus, registry );
         mAction = action;
         mTileDragTestResult = nullptr;
+        mPushBudget = pushBudget;
         return true;
     }
     return false;
@@ -29,6 +31,7 @@ bool PathSearchCriteria::setTileDragCriteria( PieceType focus, const Piece* targ
         mCriteriaType = TileDragTestCriteria;
         mTargetPoint = *target;
         mAction = nullptr;
+        mPushBudget = 0;
 
         // prime the result here while we have the piece reference & we are running on the app thread
         result->mPossibleApproaches.clear();
@@ -60,6 +63,7 @@ PathSearchCriteria& PathSearchCriteria::operator =(const PathSearchCriteria othe
     mFocus              = other.mFocus;
     mAction             = other.mAction;
     mTileDragTestResult = other.mTileDragTestResult;
+    mPushBudget         = other.mPushBudget;
     return *this;
 }
 
@@ -69,6 +73,7 @@ bool PathSearchCriteria::operator ==(const PathSearchCriteria other)
          && mFocus              == other.mFocus
          && mAction             == other.mAction
          && mTileDragTestResult == other.mTileDragTestResult
+         && mPushBudget         == other.mPushBudget
          && mStartVector.equals( other.mStartVector )
          && mTargetPoint.equals( other.mTargetPoint );
 }
@@ -146,3 +151,8 @@ TileDragTestResult* PathSearchCriteria::getTileDragTestResult() const
 {
     return mTileDragTestResult;
 }
+
+int PathSearchCriteria::getPushBudget() const
+{
+    return mPushBudget;
+}
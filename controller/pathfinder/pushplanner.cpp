@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <map>
+
+#include "pushplanner.h"
+#include "controller/game.h"
+
+// terrain flags:
+#define TANK_OK  1 // the tank can occupy the square
+#define PIECE_OK 2 // a pushed piece can occupy the square
+#define SINKS    4 // a pushed piece drops into the square
+
+// row, column offsets for direction numbers 0..3 (i.e. angle/90)
+static const int rowOffsets[4] = { -1, 0, 1,  0 };
+static const int colOffsets[4] = {  0, 1, 0, -1 };
+
+PushPlanner::PushPlanner( RouteSearch& routeSearch ) : mRouteSearch(routeSearch), mTerrain(BoardMaxWidth*BoardMaxHeight),
+  mOccupant(BoardMaxWidth*BoardMaxHeight), mVisit(BoardMaxWidth*BoardMaxHeight), mStamp{0}
+{
+}
+
+void PushPlanner::init( const BoardSnapshot& snapshot, const std::vector<ModelPoint>& blockedPoints )
+{
+    mMaxPoint = snapshot.getLowerRight();
+    mPieces.clear();
+    std::fill( mOccupant.begin(), mOccupant.end(), 0 );
+
+    ModelPoint point;
+    for( point.mRow = 0; point.mRow <= mMaxPoint.mRow; ++point.mRow ) {
+        for( point.mCol = 0; point.mCol <= mMaxPoint.mCol; ++point.mCol ) {
+            unsigned char terrain;
+            switch( snapshot.tileAt( point ) ) {
+            case DIRT:
+            case TILE_SUNK: terrain = TANK_OK|PIECE_OK; break;
+            case FLAG:      terrain = TANK_OK;          break;
+            case WATER:     terrain = PIECE_OK|SINKS;   break;
+            default:        terrain = 0;                break;
+            }
+            mTerrain[point.mRow*BoardMaxWidth + point.mCol] = terrain;
+
+            int angle;
+            PieceType type = snapshot.pieceAt( point, &angle );
+            if ( type != NONE ) {
+                mPieces.push_back( { type, angle } );
+                mOccupant[point.mRow*BoardMaxWidth + point.mCol] = static_cast<int>(mPieces.size());
+            }
+        }
+    }
+
+    for( auto point : blockedPoints ) {
+        mTerrain[point.mRow*BoardMaxWidth + point.mCol] = 0;
+    }
+}
+
+bool PushPlanner::step( int square, int direction, int* to ) const
+{
+    int col = square % BoardMaxWidth + colOffsets[direction];
+    int row = square / BoardMaxWidth + rowOffsets[direction];
+    if ( col >= 0 && col <= mMaxPoint.mCol && row >= 0 && row <= mMaxPoint.mRow ) {
+        *to = row*BoardMaxWidth + col;
+        return true;
+    }
+    return false;
+}
+
+bool PushPlanner::passable( int square ) const
+{
+    return (mTerrain[square] & TANK_OK) && !mOccupant[square];
+}
+
+bool PushPlanner::canPush( int piece, int square, int direction ) const
+{
+    SimplePiece simple( mPieces[piece].mType, square % BoardMaxWidth, square / BoardMaxWidth, mPieces[piece].mAngle );
+    return Game::canPushPiece( &simple, direction * 90 );
+}
+
+bool PushPlanner::isFrozen( int piece, int square ) const
+{
+    // frozen if no direction has both a square for the tank to push from and a square to push into
+    for( int direction = 0; direction < 4; ++direction ) {
+        int from, to;
+        if ( step( square, (direction + 2) % 4, &from ) && (mTerrain[from] & TANK_OK)
+          && step( square, direction, &to ) && (mTerrain[to] & PIECE_OK)
+          && canPush( piece, square, direction ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PushPlanner::applyPush( int from, int direction )
+{
+    int to;
+    if ( step( from, direction, &to ) ) {
+        int piece = mOccupant[from] - 1;
+        mUndo.push_back( { from, to, piece, mTerrain[to] } );
+        mOccupant[from] = 0;
+        if ( !(mTerrain[to] & SINKS) ) {
+            mOccupant[to] = piece + 1;
+        } else if ( mPieces[piece].mType == TILE ) {
+            mTerrain[to] = TANK_OK|PIECE_OK;
+        }
+    }
+}
+
+void PushPlanner::revertPushes()
+{
+    while( !mUndo.empty() ) {
+        const PlannerUndo& undo = mUndo.back();
+        mOccupant[undo.mTo] = 0;
+        mTerrain[undo.mTo] = undo.mTerrain;
+        mOccupant[undo.mFrom] = undo.mPiece + 1;
+        mUndo.pop_back();
+    }
+}
+
+void PushPlanner::applyChain( int node )
+{
+    std::vector<int> chain;
+    for( ; node > 0; node = mNodes[node].mParent ) {
+        chain.push_back( node );
+    }
+    for( auto it = chain.rbegin(); it != chain.rend(); ++it ) {
+        applyPush( mNodes[*it].mTank, mNodes[*it].mDirection );
+    }
+}
+
+int PushPlanner::flood( int tank )
+{
+    if ( !++mStamp ) {
+        std::fill( mVisit.begin(), mVisit.end(), 0 );
+        mStamp = 1;
+    }
+
+    mRegion.clear();
+    mRegion.push_back( tank );
+    mVisit[tank] = mStamp;
+    int regionMin = tank;
+    for( unsigned pullIndex = 0; pullIndex < mRegion.size(); ++pullIndex ) {
+        int square = mRegion[pullIndex];
+        for( int direction = 0; direction < 4; ++direction ) {
+            int to;
+            if ( step( square, direction, &to ) && mVisit[to] != mStamp && passable( to ) ) {
+                mVisit[to] = mStamp;
+                mRegion.push_back( to );
+                regionMin = std::min( regionMin, to );
+            }
+        }
+    }
+    return regionMin;
+}
+
+bool PushPlanner::appendWalk( int from, int* heading, int to, std::vector<int>& steps, const bool& stopping )
+{
+    std::vector<int> headings;
+    ModelVector start( from % BoardMaxWidth, from / BoardMaxWidth, *heading * 90 );
+    ModelPoint target( to % BoardMaxWidth, to / BoardMaxWidth );
+    if ( !mRouteSearch.search( start, target, mMaxPoint, [this]( int square ) { return passable( square ); },
+                               stopping, headings ) ) {
+        return false;
+    }
+    if ( !headings.empty() ) {
+        *heading = headings.back();
+    }
+    steps.insert( steps.end(), headings.begin(), headings.end() );
+    return true;
+}
+
+std::vector<int> PushPlanner::stateKey( int regionMin )
+{
+    // where each displaced piece ended up; sunk or lost pieces are encoded negatively
+    std::map<int,int> locations;
+    for( const auto& undo : mUndo ) {
+        locations[undo.mPiece] = (mOccupant[undo.mTo] == undo.mPiece + 1) ? undo.mTo : -undo.mTo - 1;
+    }
+
+    std::vector<int> key;
+    key.push_back( regionMin );
+    for( auto it : locations ) {
+        key.push_back( it.first );
+        key.push_back( it.second );
+    }
+    return key;
+}
+
+int PushPlanner::getNodeCount() const
+{
+    return static_cast<int>( mNodes.size() );
+}
+
+bool PushPlanner::plan( const ModelVector& start, const ModelPoint& target, int pushBudget, PieceListManager& moves,
+                        const bool& stopping )
+{
+    mNodes.clear();
+    mSeen.clear();
+    revertPushes();
+
+    if ( target.mCol < 0 || target.mCol > mMaxPoint.mCol || target.mRow < 0 || target.mRow > mMaxPoint.mRow ) {
+        return false;
+    }
+    int startSquare  = start.mRow *BoardMaxWidth + start.mCol;
+    int targetSquare = target.mRow*BoardMaxWidth + target.mCol;
+
+    int solution = -1;
+    mNodes.push_back( { -1, 0, startSquare, -1 } );
+    for( int node = 0; node < static_cast<int>(mNodes.size()) && !stopping; ++node ) {
+        applyChain( node );
+        int regionMin = flood( mNodes[node].mTank );
+        if ( mVisit[targetSquare] == mStamp ) {
+            revertPushes();
+            solution = node;
+            break;
+        }
+
+        int depth = mNodes[node].mDepth;
+        if ( mSeen.insert( stateKey( regionMin ) ).second && depth < pushBudget ) {
+            for( int square : mRegion ) {
+                for( int direction = 0; direction < 4; ++direction ) {
+                    int from, to;
+                    if ( step( square, direction, &from ) && mOccupant[from]
+                      && step( from, direction, &to ) && (mTerrain[to] & PIECE_OK) && !mOccupant[to]
+                      && canPush( mOccupant[from]-1, from, direction ) ) {
+
+                        // Prune dead pushes: wedging a piece where it can never move again only helps if doing so
+                        // opens up new ground beyond the square it vacates
+                        if ( !(mTerrain[to] & SINKS) && isFrozen( mOccupant[from]-1, to ) ) {
+                            if ( to == targetSquare ) {
+                                continue;
+                            }
+                            bool opensGround = false;
+                            for( int beyond = 0; beyond < 4 && !opensGround; ++beyond ) {
+                                int next;
+                                opensGround = step( from, beyond, &next ) && next != square && next != to
+                                           && mVisit[next] != mStamp && passable( next );
+                            }
+                            if ( !opensGround ) {
+                                continue;
+                            }
+                        }
+
+                        if ( static_cast<int>(mNodes.size()) < PushPlannerMaxNodes ) {
+                            mNodes.push_back( { node, depth+1, from, direction } );
+                        }
+                    }
+                }
+            }
+        }
+        revertPushes();
+    }
+    if ( solution < 0 ) {
+        return false;
+    }
+
+    std::vector<int> chain;
+    for( int node = solution; node > 0; node = mNodes[node].mParent ) {
+        chain.push_back( node );
+    }
+    // Rebuild the route as a sequence of steps. Each step is a direction number with the pushed piece number + 1
+    // in the upper bits. The walks between pushes are routed for the least driving time.
+    std::vector<int> steps;
+    int tank = startSquare;
+    int heading = (start.mAngle / 90) & 3;
+    bool routed = true;
+    for( auto it = chain.rbegin(); it != chain.rend() && routed; ++it ) {
+        int from = mNodes[*it].mTank;
+        int direction = mNodes[*it].mDirection;
+        int approach;
+        step( from, (direction + 2) % 4, &approach );
+        routed = appendWalk( tank, &heading, approach, steps, stopping );
+        steps.push_back( direction | (mOccupant[from] << 2) );
+        applyPush( from, direction );
+        tank = from;
+        heading = direction;
+    }
+    routed = routed && appendWalk( tank, &heading, targetSquare, steps, stopping );
+    revertPushes();
+    if ( !routed ) {
+        return false;
+    }
+
+    // Convert to moves, tagging the move into each pushed piece's square:
+    moves.reset();
+    ModelVector curVector( start );
+    int pushedPiece = -1;
+    int pushedFrom = -1;
+    for( int stepCode : steps ) {
+        curVector.mAngle = (stepCode & 3) * 90;
+        if ( !curVector.equals( start ) ) {
+            if ( pushedPiece >= 0 && curVector.mRow*BoardMaxWidth + curVector.mCol == pushedFrom ) {
+                SimplePiece pushed( mPieces[pushedPiece].mType, curVector.mCol, curVector.mRow, mPieces[pushedPiece].mAngle );
+                MovePiece move( MOVE, curVector, 0, &pushed );
+                moves.append( &move );
+                pushedPiece = -1;
+            } else {
+                moves.append( MOVE, curVector );
+            }
+        }
+        curVector.mCol += colOffsets[stepCode & 3];
+        curVector.mRow += rowOffsets[stepCode & 3];
+        if ( stepCode >> 2 ) {
+            pushedPiece = (stepCode >> 2) - 1;
+            pushedFrom = curVector.mRow*BoardMaxWidth + curVector.mCol;
+        }
+    }
+    if ( pushedPiece >= 0 ) {
+        SimplePiece pushed( mPieces[pushedPiece].mType, curVector.mCol, curVector.mRow, mPieces[pushedPiece].mAngle );
+        MovePiece move( MOVE, curVector, 0, &pushed );
+        moves.append( &move );
+    } else {
+        moves.append( MOVE, curVector );
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef PUSHPLANNER_H
+#define PUSHPLANNER_H
+
+#include <set>
+#include <vector>
+
+#include "model/board.h"
+#include "model/piecelistmanager.h"
+#include "routesearch.h"
+
+// Upper bound on the number of push states considered by a single plan
+constexpr int PushPlannerMaxNodes = 20000;
+
+/**
+ * @brief Plans tank routes which may push pieces out of the way.
+ * The search runs breadth first over the number of pushes. Each state is the set of displaced pieces plus the region
+ * the tank can reach without pushing, so routes with the fewest pushes are found first.
+ */
+class PushPlanner
+{
+public:
+    /**
+     * @brief Constructor
+     * @param routeSearch Used to find the quickest walk between pushes
+     */
+    PushPlanner( RouteSearch& routeSearch );
+
+    /**
+     * @brief Initialize the board for a subsequent plan
+     * @param snapshot The board state to plan against
+     * @param blockedPoints Squares to treat as permanently blocked (e.g. targets of pushes in progress)
+     */
+    void init( const BoardSnapshot& snapshot, const std::vector<ModelPoint>& blockedPoints );
+
+    /**
+     * @brief Search for a route from start to target using at most pushBudget pushes
+     * @param start The tank's starting vector
+     * @param target The square to reach
+     * @param pushBudget The maximum number of pushes to use
+     * @param moves Receives the route in the same form as PathFinder's direct paths. Moves which push are tagged with
+     * the pushed piece.
+     * @param stopping Polled to abandon the search early
+     * @return true if a route was found
+     */
+    bool plan( const ModelVector& start, const ModelPoint& target, int pushBudget, PieceListManager& moves,
+               const bool& stopping );
+
+    /**
+     * @brief Get the number of push states generated by the last plan
+     */
+    int getNodeCount() const;
+
+private:
+    typedef struct {
+        PieceType mType;
+        int mAngle;
+    } PlannerPiece;
+
+    typedef struct {
+        int mParent;
+        int mDepth;
+        int mTank;      // square the tank stands on having made the push
+        int mDirection; // direction number (0..3) of the push that created this node
+    } PlannerNode;
+
+    typedef struct {
+        int mFrom;
+        int mTo;
+        int mPiece;
+        unsigned char mTerrain;
+    } PlannerUndo;
+
+    bool step( int square, int direction, int* to ) const;
+    bool passable( int square ) const;
+    bool canPush( int piece, int square, int direction ) const;
+    bool isFrozen( int piece, int square ) const;
+    void applyPush( int from, int direction );
+    void revertPushes();
+    void applyChain( int node );
+    int flood( int tank );
+    bool appendWalk( int from, int* heading, int to, std::vector<int>& steps, const bool& stopping );
+    std::vector<int> stateKey( int regionMin );
+
+    RouteSearch& mRouteSearch;
+    ModelPoint mMaxPoint;
+    std::vector<unsigned char> mTerrain;
+    std::vector<int> mOccupant; // piece index + 1 for each square, or 0
+    std::vector<PlannerPiece> mPieces;
+
+    std::vector<PlannerNode> mNodes;
+    std::vector<PlannerUndo> mUndo;
+    std::set<std::vector<int>> mSeen;
+
+    // flood fill working storage
+    std::vector<unsigned> mVisit;
+    std::vector<int> mRegion;
+    unsigned mStamp;
+};
+
+#endif // PUSHPLANNER_H
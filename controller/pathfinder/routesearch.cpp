@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "routesearch.h"
+
+const int RouteSearch::RowOffsets[4] = { -1, 0, 1,  0 };
+const int RouteSearch::ColOffsets[4] = {  0, 1, 0, -1 };
+
+RouteSearch::RouteSearch() : mMoveCost{DefaultPathMoveCost}, mRotateCost{DefaultPathRotateCost},
+  mStateCost(BoardMaxWidth*BoardMaxHeight*4), mStateStamp(BoardMaxWidth*BoardMaxHeight*4),
+  mStateVia(BoardMaxWidth*BoardMaxHeight*4), mSearchStamp{0}, mExpandedCount{0}
+{
+}
+
+void RouteSearch::setCosts( int moveCost, int rotateCost )
+{
+    mMoveCost = moveCost;
+    mRotateCost = rotateCost;
+}
+
+int RouteSearch::getMoveCost() const
+{
+    return mMoveCost;
+}
+
+int RouteSearch::getRotateCost() const
+{
+    return mRotateCost;
+}
+
+unsigned long RouteSearch::getExpandedCount() const
+{
+    return mExpandedCount;
+}
+
+int RouteSearch::estimateCost( int square, int heading, int targetSquare ) const
+{
+    int dCol = targetSquare % BoardMaxWidth - square % BoardMaxWidth;
+    int dRow = targetSquare / BoardMaxWidth - square / BoardMaxWidth;
+
+    // the fewest turns needed to face each direction the target lies in:
+    int turns = 0;
+    int colHeading = dCol > 0 ? 1 : 3;
+    int rowHeading = dRow > 0 ? 2 : 0;
+    if ( dCol && dRow ) {
+        turns = (heading == colHeading || heading == rowHeading) ? 1 : 2;
+    } else if ( dCol ) {
+        turns = heading == colHeading ? 0 : (heading == (colHeading + 2) % 4 ? 2 : 1);
+    } else if ( dRow ) {
+        turns = heading == rowHeading ? 0 : (heading == (rowHeading + 2) % 4 ? 2 : 1);
+    }
+    return (abs(dCol) + abs(dRow)) * mMoveCost + turns * mRotateCost;
+}
+
+void RouteSearch::relax( int state, int cost, int via, int targetSquare )
+{
+    if ( mStateStamp[state] != mSearchStamp || cost < mStateCost[state] ) {
+        mStateStamp[state] = mSearchStamp;
+        mStateCost[state] = cost;
+        mStateVia[state] = static_cast<signed char>(via);
+        mOpen.push( { cost + estimateCost( state >> 2, state & 3, targetSquare ), state } );
+    }
+}
+
+bool RouteSearch::buildHeadings( int goal, std::vector<int>& headings ) const
+{
+    // walk back to collect the headings moved in:
+    for( int state = goal; mStateVia[state] != ViaStart; ) {
+        int heading = state & 3;
+        switch( mStateVia[state] ) {
+        case ViaMove:
+            headings.push_back( heading );
+            state = (((state >> 2) - RowOffsets[heading]*BoardMaxWidth - ColOffsets[heading]) << 2) | heading;
+            break;
+        case ViaRight:
+            state = (state & ~3) | ((heading + 3) % 4);
+            break;
+        default:
+            state = (state & ~3) | ((heading + 1) % 4);
+            break;
+        }
+    }
+    std::reverse( headings.begin(), headings.end() );
+    return true;
+}
+
+void RouteSearch::appendMoves( const ModelVector& start, const std::vector<int>& headings, PieceListManager& moves )
+{
+    ModelVector curVector( start );
+    for( int heading : headings ) {
+        curVector.mAngle = heading * 90;
+        if ( !curVector.equals( start ) ) {
+            moves.append( MOVE, curVector );
+        }
+        curVector.mCol += ColOffsets[heading];
+        curVector.mRow += RowOffsets[heading];
+    }
+    moves.append( MOVE, curVector );
+}
@@ -0,0 +1,141 @@
+#ifndef ROUTESEARCH_H
+#define ROUTESEARCH_H
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "model/board.h"
+#include "model/piecelistmanager.h"
+
+// Relative route costs used until configured otherwise: moving one square, and rotating 90 degrees
+constexpr int DefaultPathMoveCost   = 1;
+constexpr int DefaultPathRotateCost = 1;
+
+/**
+ * @brief Finds the tank route to a square which takes the least time to drive.
+ * Runs A* over square and heading so that turns are charged for as well as moves. The heuristic is the Manhattan
+ * distance plus the fewest turns needed to face the target, which never overestimates.
+ */
+class RouteSearch
+{
+public:
+    RouteSearch();
+
+    /**
+     * @brief Set the cost of moving one square and of rotating 90 degrees
+     */
+    void setCosts( int moveCost, int rotateCost );
+    int getMoveCost() const;
+    int getRotateCost() const;
+
+    /**
+     * @brief Get the running total of search states expanded by this instance
+     */
+    unsigned long getExpandedCount() const;
+
+    /**
+     * @brief Search for the cheapest route
+     * @param start The starting square and heading
+     * @param target The square to reach, in any heading
+     * @param maxPoint The lower right square of the board
+     * @param passable Callable taking a square offset (row * BoardMaxWidth + col) which returns true if the tank can
+     * enter the square
+     * @param stopping Polled to abandon the search early
+     * @param headings Receives the heading number (angle/90) of each move in order. Empty if start is on target.
+     * @return true if a route was found
+     */
+    template<class Passable>
+    bool search( const ModelVector& start, const ModelPoint& target, const ModelPoint& maxPoint, Passable passable,
+                 const bool& stopping, std::vector<int>& headings );
+
+    /**
+     * @brief Append moves for the given headings in the path finder's form. Each move is the square moved from
+     * facing the direction moved in, followed by the final square.
+     */
+    static void appendMoves( const ModelVector& start, const std::vector<int>& headings, PieceListManager& moves );
+
+    // row, column offsets for headings 0..3
+    static const int RowOffsets[4];
+    static const int ColOffsets[4];
+
+private:
+    typedef std::pair<int,int> OpenEntry; // { estimated total cost, state }
+
+    // how a search state was reached:
+    enum {
+        ViaStart = -1,
+        ViaMove,
+        ViaRight,
+        ViaLeft
+    };
+
+    int estimateCost( int square, int heading, int targetSquare ) const;
+    void relax( int state, int cost, int via, int targetSquare );
+    bool buildHeadings( int goal, std::vector<int>& headings ) const;
+
+    int mMoveCost;
+    int mRotateCost;
+
+    // per state (square offset * 4 + heading) storage:
+    std::vector<int> mStateCost;
+    std::vector<unsigned> mStateStamp;
+    std::vector<signed char> mStateVia;
+    unsigned mSearchStamp;
+    unsigned long mExpandedCount;
+
+    std::priority_queue<OpenEntry,std::vector<OpenEntry>,std::greater<OpenEntry>> mOpen;
+};
+
+template<class Passable>
+bool RouteSearch::search( const ModelVector& start, const ModelPoint& target, const ModelPoint& maxPoint,
+                          Passable passable, const bool& stopping, std::vector<int>& headings )
+{
+    headings.clear();
+    if ( target.mCol < 0 || target.mCol > maxPoint.mCol || target.mRow < 0 || target.mRow > maxPoint.mRow ) {
+        return false;
+    }
+    if ( target.equals( start ) ) {
+        return true;
+    }
+    int targetSquare = target.mRow*BoardMaxWidth + target.mCol;
+    if ( !passable( targetSquare ) ) {
+        return false;
+    }
+
+    if ( !++mSearchStamp ) {
+        std::fill( mStateStamp.begin(), mStateStamp.end(), 0 );
+        mSearchStamp = 1;
+    }
+    mOpen = decltype(mOpen)();
+
+    relax( ((start.mRow*BoardMaxWidth + start.mCol) << 2) | ((start.mAngle / 90) & 3), 0, ViaStart, targetSquare );
+    while( !mOpen.empty() && !stopping ) {
+        OpenEntry entry = mOpen.top();
+        mOpen.pop();
+        int state = entry.second;
+        int cost = mStateCost[state];
+        int square = state >> 2;
+        int heading = state & 3;
+        if ( entry.first != cost + estimateCost( square, heading, targetSquare ) ) {
+            continue; // superseded
+        }
+        ++mExpandedCount;
+        if ( square == targetSquare ) {
+            return buildHeadings( state, headings );
+        }
+
+        int col = square % BoardMaxWidth + ColOffsets[heading];
+        int row = square / BoardMaxWidth + RowOffsets[heading];
+        if ( col >= 0 && col <= maxPoint.mCol && row >= 0 && row <= maxPoint.mRow
+          && passable( row*BoardMaxWidth + col ) ) {
+            relax( ((row*BoardMaxWidth + col) << 2) | heading, cost + mMoveCost, ViaMove, targetSquare );
+        }
+        relax( (square << 2) | ((heading + 1) % 4), cost + mRotateCost, ViaRight, targetSquare );
+        relax( (square << 2) | ((heading + 3) % 4), cost + mRotateCost, ViaLeft, targetSquare );
+    }
+    return false;
+}
+
+#endif // ROUTESEARCH_H
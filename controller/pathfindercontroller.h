@@ -65,6 +65,13 @@ public:
      */
     bool buildTilePushPath( const ModelVector& target );
 
+    /**
+     * @brief Set how found paths are ranked
+     * @param moveCost The cost of moving one square
+     * @param rotateCost The cost of rotating 90 degrees
+     */
+    void setPathCosts( int moveCost, int rotateCost );
+
 signals:
     /**
      * @brief Notification of an action result
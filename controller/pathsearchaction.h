@@ -23,9 +23,10 @@ public:
      * The starting point is determined by the focus parameter
      * @param focus Identifies the starting point. Either TANK or MOVE.
      * @param target The square to find a path to.
+     * @param pushBudget The maximum number of pieces the path may push out of the way
      * @return true if valid search criteria constructed successfully
      */
-    bool setCriteria( PieceType focus, const ModelPoint& target );
+    bool setCriteria( PieceType focus, const ModelPoint& target, int pushBudget = DefaultPathPushBudget );
 
     PathSearchCriteria& getCriteria();
 
@@ -8,6 +8,12 @@ QT_FORWARD_DECLARE_CLASS(QAction)
 class GameRegistry;
 class TileDragTestResult;
 
+// The number of pushes a path search may use by default when no direct path exists
+constexpr int DefaultPathPushBudget = 0;
+
+// The number of pushes a path the player asks for may use when no direct path exists
+constexpr int PlayerPathPushBudget = 2;
+
 class PathSearchCriteria
 {
 public:
@@ -27,9 +33,10 @@ public:
      * @param focus Identifies the starting point. Either TANK or MOVE.
      * @param target The square to find a path to
      * @param action A QAction to be controlled by the result of the testing this criteria
+     * @param pushBudget The maximum number of pieces the path may push out of the way
      * @return true if initialized successfully
      */
-    bool setPathCriteria( PieceType focus, const ModelPoint& target, QAction* action );
+    bool setPathCriteria( PieceType focus, const ModelPoint& target, QAction* action, int pushBudget = 0 );
 
     /**
      * @brief Set criteria for testing drag points for a target tile
@@ -57,6 +64,7 @@ public:
     int getTargetRow() const;
     PieceType getFocus() const;
     TileDragTestResult* getTileDragTestResult() const;
+    int getPushBudget() const;
 
 
     /**
@@ -75,6 +83,7 @@ protected:
     PieceType mFocus;
     QAction* mAction;
     TileDragTestResult* mTileDragTestResult;
+    int mPushBudget;
 };
 
 #endif // PATHSEARCHCRITERIA_H
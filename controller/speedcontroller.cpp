@@ -41,6 +41,30 @@ int SpeedController::getSpeed()
     return mSpeed;
 }
 
+GameClock& SpeedController::getClock()
+{
+    return mClock;
+}
+
+qreal SpeedController::getSpeedMultiplier() const
+{
+    return mClock.getRate();
+}
+
+void SpeedController::setSpeedMultiplier( qreal multiplier )
+{
+    qreal previous = mClock.getRate();
+    mClock.setRate( multiplier );
+    if ( mClock.getRate() != previous ) {
+        emit speedMultiplierChanged( mClock.getRate() );
+    }
+}
+
+void SpeedController::stepSpeedMultiplier( bool faster )
+{
+    setSpeedMultiplier( faster ? mClock.getRate() * 2 : mClock.getRate() / 2 );
+}
+
 bool SpeedController::getHighSpeed() const
 {
     return mHighSpeed;
@@ -70,21 +94,21 @@ void SpeedControlledAnimation::setController(SpeedController *controller)
 void SpeedControlledAnimation::setSpeed(int speed)
 {
     if ( state() == QPropertyAnimation::Running ) {
-        int newDuration = abs(endValue().toInt() - currentValue().toInt()) * speed / getDivisor();
+        int newDuration = getDuration( endValue().toInt() - currentValue().toInt(), speed );
         if ( newDuration > 0 ) {
             setDuration( newDuration );
         }
     }
 }
 
-int MoveSpeedControlledAnimation::getDivisor()
+int SpeedControlledAnimation::getDivisor() const
 {
-    return 24;
+    return mDivisor;
 }
 
-int RotateSpeedControlledAnimation::getDivisor()
+int SpeedControlledAnimation::getDuration( int range, int speed ) const
 {
-    return 90;
+    return abs( range ) * speed / mDivisor;
 }
 
 bool SpeedControlledAnimation::animateBetween( int from, int to )
@@ -93,7 +117,8 @@ bool SpeedControlledAnimation::animateBetween( int from, int to )
         stop();
         setStartValue( from );
         setEndValue( to );
-        setDuration( abs( to-from ) * mController->getSpeed() / getDivisor() );
+        // turbo skips the animation; with no duration it lands on its end value and finishes within start()
+        setDuration( mController->getClock().getTurbo() ? 0 : getDuration( to-from, mController->getSpeed() ) );
         start();
         return true;
     }
@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QPropertyAnimation>
 
+#include "gameclock.h"
+
 class Game;
 
 /**
@@ -36,6 +38,16 @@ public:
      */
     void stepSpeed();
 
+    /**
+     * @brief Access the clock used to fast-forward the game's animations
+     */
+    GameClock& getClock();
+
+    /**
+     * @brief Get the multiplier applied to the speed of all game animations
+     */
+    qreal getSpeedMultiplier() const;
+
 public slots:
     /**
      * @brief Set the high speed override value
@@ -48,8 +60,21 @@ public slots:
      */
     void toggleHighSpeed();
 
+    /**
+     * @brief Set the multiplier applied to the speed of all game animations including shots
+     * @param multiplier A value between GameClock::MinRate and GameClock::MaxRate. 1 is normal.
+     */
+    void setSpeedMultiplier( qreal multiplier );
+
+    /**
+     * @brief Double or halve the speed multiplier
+     * @param faster Doubles if true otherwise halves
+     */
+    void stepSpeedMultiplier( bool faster );
+
 signals:
     void highSpeedChanged( int speed );
+    void speedMultiplierChanged( qreal multiplier );
 
 private:
     int desiredSpeed();
@@ -57,6 +82,7 @@ private:
     bool mHighSpeed;
     bool mStepPending;
     int mSpeed;
+    GameClock mClock;
 };
 
 /**
@@ -67,7 +93,8 @@ class SpeedControlledAnimation : public QPropertyAnimation
     Q_OBJECT
 
 public:
-    SpeedControlledAnimation( QObject* parent = nullptr ) : QPropertyAnimation(parent), mController(nullptr)
+    SpeedControlledAnimation( int divisor, QObject* parent = nullptr ) : QPropertyAnimation(parent), mController(nullptr),
+      mDivisor(divisor)
     {
     }
 
@@ -79,6 +106,8 @@ public:
 
     /**
      * @brief Helper method to start an animation between a given range
+     * While the controller's clock is in turbo mode the animation is skipped: it is set to the ending value and
+     * finishes before this returns.
      * @param from The starting value
      * @param to The ending value
      * @return true if the animation is started
@@ -86,10 +115,17 @@ public:
     bool animateBetween( int from, int to );
 
     /**
-     * @brief Get the divisor. A divisor is the distance to travel in one second.
+     * @brief Get the divisor. A divisor is the distance travelled in the speed's time (i.e. ms per square).
      * @return
      */
-    virtual int getDivisor() = 0;
+    int getDivisor() const;
+
+    /**
+     * @brief The time in milliseconds this animation takes to cover the given range
+     * @param range The distance between the start and end values
+     * @param speed The speed in ms per square
+     */
+    int getDuration( int range, int speed ) const;
 
 public slots:
     void setSpeed( int speed );
@@ -99,28 +135,28 @@ signals:
 
 protected:
     SpeedController* mController;
+
+private:
+    int mDivisor;
 };
 
 class MoveSpeedControlledAnimation : public SpeedControlledAnimation
 {
     Q_OBJECT
 public:
-    MoveSpeedControlledAnimation( QObject* parent = nullptr ) : SpeedControlledAnimation(parent)
+    MoveSpeedControlledAnimation( QObject* parent = nullptr ) : SpeedControlledAnimation(24,parent)
     {
     }
-
-    int getDivisor() override;
 };
 
 class RotateSpeedControlledAnimation : public SpeedControlledAnimation
 {
     Q_OBJECT
 public:
-    RotateSpeedControlledAnimation( QObject* parent = nullptr ) : SpeedControlledAnimation(parent)
+    RotateSpeedControlledAnimation( QObject* parent = nullptr ) : SpeedControlledAnimation(90,parent)
     {
     }
 
-    int getDivisor() override;
     bool animateBetween( int fromAngle, int toAngle );
 };
 
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <vector>
+#include <QStringList>
+#include <QTextStream>
+
+#include "util/mapgenerator.h"
+
+static void usage( const char* name )
+{
+    std::cerr << "usage: " << name << " [open|maze|mirrors] [-w width] [-h height] [-s seed]"
+              << " [-walls n] [-water n] [-mirrors n] [-wood n] [-tiles n] [-cannons n]" << std::endl
+              << "  densities are per mille of the dirt squares" << std::endl;
+}
+
+int main( int argc, char** argv )
+{
+    MapGenerator::Layout layout = MapGenerator::OpenField;
+    int width = 64, height = 64;
+    unsigned seed = 1;
+    std::vector<std::pair<void (MapGenerator::*)(int),int>> densities;
+
+    for( int i = 1; i < argc; ++i ) {
+        QString arg( argv[i] );
+        if ( arg == "open" ) {
+            layout = MapGenerator::OpenField;
+        } else if ( arg == "maze" ) {
+            layout = MapGenerator::Maze;
+        } else if ( arg == "mirrors" ) {
+            layout = MapGenerator::MirrorField;
+        } else if ( arg.startsWith( '-' ) && i+1 < argc ) {
+            bool ok;
+            int value = QString( argv[++i] ).toInt( &ok );
+            if ( !ok || value < 0 ) {
+                usage( argv[0] );
+                return 1;
+            }
+            if      ( arg == "-w" )        width  = value;
+            else if ( arg == "-h" )        height = value;
+            else if ( arg == "-s" )        seed   = static_cast<unsigned>(value);
+            else if ( arg == "-walls" )    densities.push_back( { &MapGenerator::setWallDensity,   value } );
+            else if ( arg == "-water" )    densities.push_back( { &MapGenerator::setWaterDensity,  value } );
+            else if ( arg == "-mirrors" )  densities.push_back( { &MapGenerator::setMirrorDensity, value } );
+            else if ( arg == "-wood" )     densities.push_back( { &MapGenerator::setWoodDensity,   value } );
+            else if ( arg == "-tiles" )    densities.push_back( { &MapGenerator::setTileDensity,   value } );
+            else if ( arg == "-cannons" )  densities.push_back( { &MapGenerator::setCannonDensity, value } );
+            else {
+                usage( argv[0] );
+                return 1;
+            }
+        } else {
+            usage( argv[0] );
+            return 1;
+        }
+    }
+
+    MapGenerator generator( width, height, seed );
+    for( auto it : densities ) {
+        (generator.*it.first)( it.second );
+    }
+
+    QTextStream stream(stdout);
+    stream << generator.generate( layout );
+    return 0;
+}
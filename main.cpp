@@ -1,19 +1,88 @@
+#include <cstring>
+#include <iostream>
 #include <qglobal.h>
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include "controller/evalserver.h"
 #include "controller/gameinitializer.h"
 #include "controller/gameregistry.h"
+#include "util/trace.h"
 
+/**
+ * @brief Create the application. Serving is headless so doesn't need (or want) a display.
+ */
+static QCoreApplication* createApplication( int& argc, char *argv[] )
+{
+    for( int i = 1; i < argc; ++i ) {
+        if ( !strcmp( argv[i], "--serve" ) ) {
+            return new QCoreApplication( argc, argv );
+        }
+    }
+    return new QApplication( argc, argv );
+}
+
+/**
+ * @brief Evaluate JSON lines requests from stdin, writing the results to stdout
+ */
+static int serve( unsigned threadCount )
+{
+    // stdout carries the results; send the diagnostics elsewhere
+    std::cout.rdbuf( std::cerr.rdbuf() );
+
+    QFile input;
+    QFile output;
+    if ( !input.open( stdin, QIODevice::ReadOnly ) || !output.open( stdout, QIODevice::WriteOnly ) ) {
+        std::cout << "** serve: couldn't open the standard streams" << std::endl;
+        return 1;
+    }
+
+    EvalServer server( threadCount );
+    int count = server.preload();
+    std::cout << "serve: " << count << " levels loaded" << std::endl;
+    server.serve( input, output );
+    return 0;
+}
 
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
+    QScopedPointer<QCoreApplication> app( createApplication( argc, argv ) );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption statsOption( "stats", "Save the performance counters to <file> on exit.", "file" );
+    parser.addOption( statsOption );
+    QCommandLineOption serveOption( "serve", "Evaluate JSON lines move list requests from stdin, writing the results to stdout." );
+    parser.addOption( serveOption );
+    QCommandLineOption threadsOption( "threads", "Evaluate on <count> threads when serving (defaults to one per core).", "count" );
+    parser.addOption( threadsOption );
+#ifdef QLT_TRACE
+    QCommandLineOption traceOption( "trace", "Save the timeline trace to <file> on exit.", "file" );
+    parser.addOption( traceOption );
+#endif // QLT_TRACE
+    parser.process( *app );
+    TRACE_THREAD_NAME( "app" );
 
     qRegisterMetaType<GameHandle>( GameHandleName );
 
+    if ( parser.isSet( serveOption ) ) {
+        return serve( parser.value( threadsOption ).toUInt() );
+    }
+
     BoardWindow window;
     GameRegistry registry( &window );
     GameInitializer initializer;
     initializer.init( registry );
 
-    return QApplication::exec();
+    int result = QApplication::exec();
+
+    if ( parser.isSet( statsOption ) ) {
+        registry.getPerfStats().save( parser.value( statsOption ) );
+    }
+#ifdef QLT_TRACE
+    if ( parser.isSet( traceOption ) ) {
+        Trace::save( parser.value( traceOption ) );
+    }
+#endif // QLT_TRACE
+    return result;
 }
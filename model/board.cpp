@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include <QVariant>
 #include <QFile>
 #include <QThread>
@@ -7,10 +9,39 @@
 #include "board.h"
 #include "controller/gameregistry.h"
 #include "util/workerthread.h"
+#include "util/trace.h"
 
-Board::Board( QObject* parent ) : QObject(parent), mLevel{0}, mLastPushId{0}, mStream{nullptr}
+BoardChangeSet::BoardChangeSet() : mTileChanges{0}, mPieceChanges{0}, mDirtExposed{false}
 {
+}
+
+void BoardChangeSet::add( const ModelPoint& point )
+{
+    if ( isEmpty() ) {
+        mTopLeft = mBottomRight = point;
+    } else {
+        mTopLeft.mCol     = std::min( mTopLeft.mCol,     point.mCol );
+        mTopLeft.mRow     = std::min( mTopLeft.mRow,     point.mRow );
+        mBottomRight.mCol = std::max( mBottomRight.mCol, point.mCol );
+        mBottomRight.mRow = std::max( mBottomRight.mRow, point.mRow );
+    }
+}
+
+bool BoardChangeSet::isEmpty() const
+{
+    return !mTileChanges && !mPieceChanges;
+}
+
+Board::Board( QObject* parent ) : QObject(parent), mLevel{0}, mLastPushId{0}, mStream{nullptr}, mVersion{0},
+  mPiecesDirty{true}, mChangeDepth{0}
+{
+    qRegisterMetaType<BoardChangeSet>("BoardChangeSet");
     memset( mTiles, EMPTY, sizeof mTiles );
+    mDirtyRows.set();
+
+    QObject::connect( &mPieceManager, &PieceManager::insertedAt, this, &Board::onPiecesChanged, Qt::DirectConnection );
+    QObject::connect( &mPieceManager, &PieceManager::erasedAt,   this, &Board::onPiecesChanged, Qt::DirectConnection );
+    QObject::connect( &mPieceManager, &PieceManager::changedAt,  this, &Board::onPiecesChanged, Qt::DirectConnection );
 }
 
 void Board::load( int level ) {
@@ -67,6 +98,8 @@ bool Board::load( const QString& fileName, int level )
 
 void Board::load( QTextStream& stream, int level )
 {
+    TRACE_SCOPE( "Board::load" );
+    beginChanges();
     int row = 0;
     unsigned char* rowp = mTiles;
     mLowerRight = ModelPoint(0,0);
@@ -75,13 +108,14 @@ void Board::load( QTextStream& stream, int level )
     mPieceManager.reset();
 
     do {
-        QString line = stream.readLine(BoardMaxWidth);
+        // not limiting the line length here since multi-character squares ("[S/") can make a full-width row longer:
+        QString line = stream.readLine();
 
         // we don't know the board width yet, so initialize the max:
         memset( rowp, EMPTY, BoardMaxWidth * (sizeof *rowp) );
 
         int i = 0, col = 0;
-        while( i < line.size() ) {
+        while( i < line.size() && col < BoardMaxWidth ) {
             QChar c = line.at(i++);
             if ( c.isSpace() ) {
                 continue;
@@ -149,12 +183,16 @@ void Board::load( QTextStream& stream, int level )
     mLevel = level;
     mLastPushId = 0;
     mStream = ( level < 0 ) ? &stream : nullptr;
+    findDeadSquares();
+    onReplaced();
+    commitChanges();
 
     emit boardLoaded( level );
 }
 
 void Board::load( const Board* source )
 {
+    beginChanges();
     mLevel        = source->mLevel;
     mLastPushId   = source->mLastPushId;
     mLowerRight   = source->mLowerRight;
@@ -162,7 +200,10 @@ void Board::load( const Board* source )
     mTankWayPoint = source->mTankWayPoint;
     memcpy( mTiles, source->mTiles, sizeof mTiles );
     mPieceManager.reset( &source->mPieceManager );
+    mDeadSquares  = source->mDeadSquares;
     mStream = nullptr;
+    onReplaced();
+    commitChanges();
     emit boardLoaded( mLevel );
 }
 
@@ -192,11 +233,140 @@ TileType Board::tileAt( const ModelPoint& point ) const {
       ? static_cast<TileType>(mTiles[point.mRow*BoardMaxWidth+point.mCol]) : EMPTY;
 }
 
+bool Board::isDeadSquare( const ModelPoint& point ) const
+{
+    return point.mCol >= 0 && point.mRow >= 0 && point.mCol <= mLowerRight.mCol && point.mRow <= mLowerRight.mRow
+        && mDeadSquares.test( point.mRow*BoardMaxWidth + point.mCol );
+}
+
+// The dead square analysis gives terrain which can change its most permissive form: water may get bridged by a sunk
+// tile and wood may get shot away.
+
+/**
+ * @brief Query whether a tile could come to rest on the given terrain
+ */
+static bool canHoldTile( TileType tile )
+{
+    switch( tile ) {
+    case DIRT:
+    case TILE_SUNK:
+    case WOOD:
+    case WOOD_DAMAGED:
+        return true;
+    default:
+        ;
+    }
+    return false;
+}
+
+/**
+ * @brief Query whether a push in the given direction could be delivered from the given terrain into its neighbor;
+ * either by the tank standing there or by a shot leaving it in that direction
+ */
+static bool canPushFrom( TileType tile, int angle )
+{
+    switch( tile ) {
+    case DIRT:
+    case TILE_SUNK:
+    case FLAG:
+    case WATER:
+    case WOOD:
+    case WOOD_DAMAGED:
+        return true;
+
+    case STONE_SLIT:    return angle == 90 || angle == 270;
+    case STONE_SLIT_90: return angle ==  0 || angle == 180;
+
+    // a mirror turns shots out through the two sides facing away from its face
+    case STONE_MIRROR:     return angle ==  90 || angle == 180;
+    case STONE_MIRROR__90: return angle == 180 || angle == 270;
+    case STONE_MIRROR_180: return angle == 270 || angle ==   0;
+    case STONE_MIRROR_270: return angle ==   0 || angle ==  90;
+
+    default:
+        ;
+    }
+    return false;
+}
+
+void Board::findDeadSquares()
+{
+    // Work backwards from the water, collecting the squares from which a single push can move a tile on to one already
+    // collected. Without water, collect those squares which have any push at all.
+    std::bitset<BoardMaxWidth*BoardMaxHeight> live;
+    std::vector<ModelPoint> pending;
+    ModelPoint point;
+    for( point.mRow = 0; point.mRow <= mLowerRight.mRow; ++point.mRow ) {
+        for( point.mCol = 0; point.mCol <= mLowerRight.mCol; ++point.mCol ) {
+            if ( tileAt( point ) == WATER ) {
+                live.set( point.mRow*BoardMaxWidth + point.mCol );
+                pending.push_back( point );
+            }
+        }
+    }
+    if ( pending.empty() ) {
+        for( point.mRow = 0; point.mRow <= mLowerRight.mRow; ++point.mRow ) {
+            for( point.mCol = 0; point.mCol <= mLowerRight.mCol; ++point.mCol ) {
+                if ( canHoldTile( tileAt( point ) ) ) {
+                    for( int angle = 0; angle < 360; angle += 90 ) {
+                        ModelPoint to( point ), pusher( point );
+                        getAdjacentPosition( angle, &to );
+                        getAdjacentPosition( (angle+180) % 360, &pusher );
+                        if ( (canHoldTile( tileAt( to ) ) || tileAt( to ) == WATER) && canPushFrom( tileAt( pusher ), angle ) ) {
+                            live.set( point.mRow*BoardMaxWidth + point.mCol );
+                            pending.push_back( point );
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    while( !pending.empty() ) {
+        ModelPoint to = pending.back();
+        pending.pop_back();
+        for( int angle = 0; angle < 360; angle += 90 ) {
+            // the tile moves from "from" to "to" when pushed from "pusher"
+            ModelPoint from( to );
+            getAdjacentPosition( (angle+180) % 360, &from );
+            if ( canHoldTile( tileAt( from ) ) && !live.test( from.mRow*BoardMaxWidth + from.mCol ) ) {
+                ModelPoint pusher( from );
+                getAdjacentPosition( (angle+180) % 360, &pusher );
+                if ( canPushFrom( tileAt( pusher ), angle ) ) {
+                    live.set( from.mRow*BoardMaxWidth + from.mCol );
+                    pending.push_back( from );
+                }
+            }
+        }
+    }
+
+    mDeadSquares.reset();
+    for( point.mRow = 0; point.mRow <= mLowerRight.mRow; ++point.mRow ) {
+        for( point.mCol = 0; point.mCol <= mLowerRight.mCol; ++point.mCol ) {
+            if ( canHoldTile( tileAt( point ) ) && !live.test( point.mRow*BoardMaxWidth + point.mCol ) ) {
+                mDeadSquares.set( point.mRow*BoardMaxWidth + point.mCol );
+            }
+        }
+    }
+}
+
 void Board::setTileAt( TileType id, ModelPoint point )
 {
     if ( point.mCol >= 0 && point.mRow >= 0 && point.mCol <= mLowerRight.mCol && point.mRow <= mLowerRight.mRow ) {
         mTiles[point.mRow*BoardMaxWidth+point.mCol] = id;
+        ++mVersion;
+        mDirtyRows.set( point.mRow );
         emit tileChangedAt( point );
+
+        mChanges.add( point );
+        ++mChanges.mTileChanges;
+        if ( id == DIRT ) {
+            mChanges.mDirtExposed = true;
+        }
+        if ( !mChangeDepth ) {
+            notifyChanges();
+        }
     }
 }
 
@@ -212,6 +382,7 @@ void Board::applyPushResult( PieceType mType, const ModelPoint& point, int piece
 
 void Board::revertPush( MovePiece* pusher )
 {
+    beginChanges();
     ModelPoint point = *pusher;
     if ( getAdjacentPosition( pusher->getAngle(), &point ) ) {
         Piece* pushee = mPieceManager.pieceAt( point );
@@ -229,6 +400,158 @@ void Board::revertPush( MovePiece* pusher )
     } else {
         std::cout << "** revertPush: failed to get adjacent pos for " << point.mCol << "," << point.mRow << std::endl;
     }
+    commitChanges();
+}
+
+unsigned long Board::getVersion() const
+{
+    return mVersion;
+}
+
+void Board::onPiecesChanged( ModelPoint point )
+{
+    ++mVersion;
+    mPiecesDirty = true;
+
+    mChanges.add( point );
+    ++mChanges.mPieceChanges;
+    if ( !mChangeDepth ) {
+        notifyChanges();
+    }
+}
+
+void Board::onReplaced()
+{
+    ++mVersion;
+    mDirtyRows.set();
+    mPiecesDirty = true;
+
+    // superseded by boardLoaded
+    mChanges = BoardChangeSet();
+}
+
+void Board::beginChanges()
+{
+    ++mChangeDepth;
+}
+
+void Board::commitChanges()
+{
+    if ( mChangeDepth > 0 && !--mChangeDepth ) {
+        notifyChanges();
+    }
+}
+
+void Board::notifyChanges()
+{
+    if ( !mChanges.isEmpty() ) {
+        BoardChangeSet changes( mChanges );
+        mChanges = BoardChangeSet();
+        emit changesCommitted( changes );
+    }
+}
+
+std::shared_ptr<const BoardSnapshot> Board::getSnapshot()
+{
+    if ( mSnapshot && mSnapshot->mVersion == mVersion && mSnapshot->mLastPushId == mLastPushId ) {
+        return mSnapshot;
+    }
+
+    std::shared_ptr<BoardSnapshot> snapshot( new BoardSnapshot() );
+    snapshot->mVersion    = mVersion;
+    snapshot->mLevel      = mLevel;
+    snapshot->mLowerRight = mLowerRight;
+    snapshot->mFlagPoint  = mFlagPoint;
+    snapshot->mLastPushId = mLastPushId;
+
+    // only copy the rows which changed since the previous snapshot
+    int rowCount = mLowerRight.mRow + 1;
+    snapshot->mRows.resize( rowCount );
+    for( int row = 0; row < rowCount; ++row ) {
+        if ( mSnapshot && !mDirtyRows.test( row ) && row < static_cast<int>(mSnapshot->mRows.size()) ) {
+            snapshot->mRows[row] = mSnapshot->mRows[row];
+        } else {
+            const unsigned char* rowp = &mTiles[row*BoardMaxWidth];
+            snapshot->mRows[row] = std::make_shared<const BoardSnapshot::TileRow>( rowp, rowp + mLowerRight.mCol + 1 );
+        }
+    }
+    mDirtyRows.reset();
+
+    if ( mSnapshot && !mPiecesDirty ) {
+        snapshot->mPieces = mSnapshot->mPieces;
+    } else {
+        std::shared_ptr<BoardSnapshot::SnapshotPieces> pieces( new BoardSnapshot::SnapshotPieces() );
+        pieces->reserve( mPieceManager.getPieces().size() );
+        // already in position order
+        for( const auto& piece : mPieceManager.getPieces() ) {
+            pieces->push_back( { piece.encodedPos(), piece.getType(), piece.getAngle(), piece.getPushedId() } );
+        }
+        snapshot->mPieces = pieces;
+        mPiecesDirty = false;
+    }
+
+    mSnapshot = snapshot;
+    return mSnapshot;
+}
+
+bool Board::restore( const BoardSnapshot& snapshot )
+{
+    if ( snapshot.mLevel != mLevel || !snapshot.mLowerRight.equals( mLowerRight ) ) {
+        std::cout << "** restore: snapshot is of a different board" << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<const BoardSnapshot> current = getSnapshot();
+    beginChanges();
+
+    // rows shared with the current state are unchanged
+    ModelPoint point;
+    for( point.mRow = 0; point.mRow <= mLowerRight.mRow; ++point.mRow ) {
+        if ( !snapshot.sharesRow( point.mRow, *current ) ) {
+            const BoardSnapshot::TileRow& tiles = *snapshot.mRows[point.mRow];
+            for( point.mCol = 0; point.mCol <= mLowerRight.mCol; ++point.mCol ) {
+                TileType tile = static_cast<TileType>( tiles[point.mCol] );
+                if ( tileAt( point ) != tile ) {
+                    setTileAt( tile, point );
+                }
+            }
+        }
+    }
+
+    if ( !snapshot.sharesPieces( *current ) ) {
+        // merge the two position ordered lists, collecting the differences before applying them
+        std::vector<ModelPoint> erasures;
+        std::vector<BoardSnapshot::SnapshotPiece> insertions;
+        const PieceVector& pieces = mPieceManager.getPieces();
+        auto have = pieces.begin();
+        auto want = snapshot.mPieces->begin();
+        while( have != pieces.end() || want != snapshot.mPieces->end() ) {
+            if ( want == snapshot.mPieces->end() || (have != pieces.end() && have->encodedPos() < want->mOffset) ) {
+                erasures.push_back( *have++ );
+            } else if ( have == pieces.end() || want->mOffset < have->encodedPos() ) {
+                insertions.push_back( *want++ );
+            } else {
+                if ( have->getType() != want->mType || have->getAngle() != want->mAngle
+                  || have->getPushedId() != want->mPushedId ) {
+                    erasures.push_back( *have );
+                    insertions.push_back( *want );
+                }
+                ++have;
+                ++want;
+            }
+        }
+        for( const auto& erasure : erasures ) {
+            mPieceManager.eraseAt( erasure );
+        }
+        for( const auto& insertion : insertions ) {
+            ModelPoint at( insertion.mOffset % PieceMaxRowCount, insertion.mOffset / PieceMaxRowCount );
+            mPieceManager.insert( insertion.mType, at, insertion.mAngle, insertion.mPushedId );
+        }
+    }
+
+    mLastPushId = snapshot.mLastPushId;
+    commitChanges();
+    return true;
 }
 
 bool getAdjacentPosition( int angle, ModelPoint *point )
@@ -246,6 +569,7 @@ bool getAdjacentPosition( int angle, ModelPoint *point )
 
 void Board::undoChanges( int undoShotCount, std::vector<FutureChange> changes )
 {
+    beginChanges();
     for( auto it = changes.end(); undoShotCount > 0 && it != changes.begin(); ) {
         --it;
         switch( it->changeType ) {
@@ -295,5 +619,6 @@ void Board::undoChanges( int undoShotCount, std::vector<FutureChange> changes )
             ;
         }
     }
+    commitChanges();
 }
 
@@ -1,12 +1,15 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <bitset>
+#include <memory>
 #include <QObject>
 
 QT_FORWARD_DECLARE_CLASS(QTextStream)
 
 #include "tile.h"
 #include "model/piecesetmanager.h"
+#include "model/boardsnapshot.h"
 #include "controller/futurechange.h"
 
 // The largest board dimensions we care to support
@@ -21,6 +24,33 @@ constexpr int BoardMaxHeight = PieceMaxRowCount;
  */
 bool getAdjacentPosition( int angle, ModelPoint *point );
 
+/**
+ * @brief Summarizes the changes a board committed in one notification
+ */
+class BoardChangeSet
+{
+public:
+    BoardChangeSet();
+
+    /**
+     * @brief Include the given square in the dirty region
+     */
+    void add( const ModelPoint& point );
+
+    /**
+     * @brief Query whether no changes are recorded
+     */
+    bool isEmpty() const;
+
+    ModelPoint mTopLeft;     // bounding region of the changed squares
+    ModelPoint mBottomRight;
+    int mTileChanges;
+    int mPieceChanges;
+    bool mDirtExposed;       // true if a square changed to DIRT (i.e. may have opened a line of fire)
+};
+
+Q_DECLARE_METATYPE(BoardChangeSet)
+
 /**
  * @brief The Board class
  * A board contains a 2D map of tiles and an associated list of pieces
@@ -63,6 +93,15 @@ public:
      */
     TileType tileAt( const ModelPoint& point ) const;
 
+    /**
+     * @brief Query whether a tile at the given square is stranded; i.e. no sequence of pushes can take it to water.
+     * Found once per level when loaded, so this is cheap to call on every push. A level without water has nothing for
+     * tiles to fill, so there only the squares a tile can never be pushed out of are stranded.
+     * @param point The square of interest
+     * @return true if a tile there can never be sunk
+     */
+    bool isDeadSquare( const ModelPoint& point ) const;
+
     /**
      * @brief Change the type for a given square
      * @param point The square to change
@@ -136,6 +175,37 @@ public:
 
     int getLastPushId() const;
 
+    /**
+     * @brief Get the number of changes made to this board. Increases with every tile or piece change and each load.
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * @brief Get an immutable copy of the board's current state. Must be called in the app thread.
+     * The snapshot is cached until the board next changes, so repeated calls are cheap. The returned snapshot may be
+     * passed to and read from any thread.
+     */
+    std::shared_ptr<const BoardSnapshot> getSnapshot();
+
+    /**
+     * @brief Return this board to the state of the given snapshot of it.
+     * Only the squares which differ are changed, and the changes are notified as a single transaction.
+     * @param snapshot A snapshot previously taken from this board (or a copy of it)
+     * @return false if the snapshot is of a different board
+     */
+    bool restore( const BoardSnapshot& snapshot );
+
+    /**
+     * @brief Start collecting changes. Until the matching commitChanges call, tile and piece changes are accumulated
+     * into a single changesCommitted notification. Transactions may nest; only the outermost commit notifies.
+     */
+    void beginChanges();
+
+    /**
+     * @brief End a transaction started by beginChanges, notifying any changes collected if it is the outermost
+     */
+    void commitChanges();
+
 signals:
     /**
      * @brief Notifies that the board is being loaded in the background
@@ -153,8 +223,24 @@ signals:
      */
     void tileChangedAt( ModelPoint point ) const;
 
+    /**
+     * @brief Signals the tile and piece changes made since the last notification. Changes made outside a transaction
+     * are notified individually. Changes made while loading are not notified (see boardLoaded).
+     * @param changes The coalesced changes
+     */
+    void changesCommitted( const BoardChangeSet& changes ) const;
+
 private:
     void initPiece( PieceType type, int col, int row, int angle = 0 );
+    void onPiecesChanged( ModelPoint point );
+    void onReplaced();
+    void notifyChanges();
+
+    /**
+     * @brief Work out the dead squares for the loaded terrain (see isDeadSquare)
+     */
+    void findDeadSquares();
+
     int mLevel;
     ModelPoint mLowerRight;
     ModelPoint mFlagPoint;
@@ -163,8 +249,19 @@ private:
 
     unsigned char mTiles[BoardMaxWidth*BoardMaxHeight];
     PieceSetManager mPieceManager;
+    std::bitset<BoardMaxWidth*BoardMaxHeight> mDeadSquares;
 
     QTextStream* mStream;
+
+    // snapshot publishing
+    unsigned long mVersion;
+    std::bitset<BoardMaxHeight> mDirtyRows;
+    bool mPiecesDirty;
+    std::shared_ptr<const BoardSnapshot> mSnapshot;
+
+    // change notification
+    int mChangeDepth;
+    BoardChangeSet mChanges;
 };
 
 #endif // BOARD_H
@@ -4,14 +4,17 @@
 #include "view/levelchooser.h"
 #include "util/workerthread.h"
 
-class PoolLoadRunnable : BasicRunnable
+class PoolLoadRunnable : public BasicRunnable
 {
 public:
-    PoolLoadRunnable() : mBoard{nullptr}, mLevel{0}
+    PoolLoadRunnable( int level, Board* board ) : mBoard{board}, mLevel{level}
     {
     }
 
-    void load( int level, Board* board );
+    const char* getName() const override
+    {
+        return "PoolLoadRunnable";
+    }
 
     void run() override
     {
@@ -23,12 +26,9 @@ public:
         return mLevel;
     }
 
-    Board* reset()
+    Board* getBoard()
     {
-        Board* ret = mBoard;
-        mBoard = nullptr;
-        mLevel = 0;
-        return ret;
+        return mBoard;
     }
 
 private:
@@ -37,14 +37,12 @@ private:
 };
 
 BoardPool::BoardPool( int visibleCount, int size ) : QObject(nullptr), mFirstVisible{0}, mVisibleCount(visibleCount),
-  mTotalSize(visibleCount + (visibleCount>>1)), mSize(size), mRunnable{nullptr}
+  mTotalSize(visibleCount + (visibleCount>>1)), mSize(size), mLevelList{nullptr}, mScrollDirection{0},
+  mScrollDirectionConfirmed{false}
 {
 }
 
-BoardPool::~BoardPool()
-{
-    delete mRunnable;
-}
+BoardPool::~BoardPool() = default;
 
 Board* BoardPool::find( int level )
 {
@@ -57,28 +55,27 @@ Board* BoardPool::find( int level )
 
 void BoardPool::onBoardLoaded( int level )
 {
-    if ( mRunnable ) {
-        if ( mRunnable->getLevel() == level ) {
-            if ( Board* board = mRunnable->reset() ) {
-                mPool[level] = board;
-                emit boardLoaded( level );
-            }
-        }
+    auto it = mLoading.find( level );
+    if ( it != mLoading.end() ) {
+        mPool[level] = it->second->getBoard();
+        mLoading.erase( it );
+        emit boardLoaded( level );
+    }
 
-        // load any next pending visible
-        if ( !mRunnable->getLevel() ) {
-            for( int level = mFirstVisible + mVisibleCount; --level >= mFirstVisible; ) {
-                if ( !find( level ) ) {
-                    mRunnable->load( level, getRecyclableBoard() );
-                    break;
-                }
-            }
+    // load any pending visible
+    for( int level = mFirstVisible + mVisibleCount; --level >= mFirstVisible && canStartLoad(); ) {
+        if ( !find( level ) ) {
+            startLoad( level );
         }
     }
+
+    prefetch();
 }
 
 void BoardPool::init( LevelList& levelList, int maxHeight )
 {
+    mLevelList = &levelList;
+
     if ( !mTotalSize ) {
         int maxLevel = levelList.size();
         int curHeight = 0;
@@ -96,6 +93,8 @@ void BoardPool::init( LevelList& levelList, int maxHeight )
 
 int BoardPool::ensureWithinVisible( int level )
 {
+    int firstVisible = mFirstVisible;
+
     // update visible tracking
     if ( !mFirstVisible ) {
         mFirstVisible = level;
@@ -104,6 +103,13 @@ int BoardPool::ensureWithinVisible( int level )
     } else if ( level >= mFirstVisible + mVisibleCount ) {
         mFirstVisible = level-mVisibleCount+1;
     }
+
+    // a direction is only trusted once it repeats, so that a single step back doesn't trigger prefetching:
+    if ( firstVisible && mFirstVisible != firstVisible ) {
+        int direction = mFirstVisible > firstVisible ? 1 : -1;
+        mScrollDirectionConfirmed = direction == mScrollDirection;
+        mScrollDirection = direction;
+    }
     return mFirstVisible;
 }
 
@@ -112,25 +118,65 @@ Board* BoardPool::getBoard( int level )
     ensureWithinVisible( level );
 
     if ( Board* board = find( level ) ) {
+        prefetch();
         return board;
     }
 
-    if ( mRunnable ) {
-        // check if currently loading a level
-        if ( mRunnable->getLevel() ) {
-            return nullptr;
+    startLoad( level );
+    prefetch();
+    return nullptr;
+}
+
+bool BoardPool::canStartLoad() const
+{
+    if ( GameRegistry* registry = getRegistry(this) ) {
+        return mLoading.size() < registry->getWorkerPool().size();
+    }
+    return false;
+}
+
+bool BoardPool::startLoad( int level, int minDistance )
+{
+    if ( mLoading.find( level ) != mLoading.end() ) {
+        return true;
+    }
+
+    if ( canStartLoad() ) {
+        if ( Board* board = getRecyclableBoard( minDistance ) ) {
+            auto runnable = std::make_shared<PoolLoadRunnable>( level, board );
+            mLoading[level] = runnable;
+            emit board->boardLoading( level );
+            getRegistry(this)->getWorkerPool().doWork( runnable );
+            return true;
         }
-    } else {
-        mRunnable = new PoolLoadRunnable();
     }
+    return false;
+}
 
-    mRunnable->load( level, getRecyclableBoard() );
-    return nullptr;
+void BoardPool::prefetch()
+{
+    if ( !mScrollDirectionConfirmed || !mLevelList || !mFirstVisible ) {
+        return;
+    }
+
+    // Prefetch into the spare capacity beyond the visible window:
+    int edge = mScrollDirection > 0 ? mFirstVisible + mVisibleCount - 1 : mFirstVisible;
+    int depth = static_cast<int>( mTotalSize ) - mVisibleCount;
+    for( int distance = 1; distance <= depth && canStartLoad(); ++distance ) {
+        int level = edge + distance * mScrollDirection;
+        if ( !mLevelList->find( level ) ) {
+            break;
+        }
+        // don't recycle boards any nearer than the one being fetched:
+        if ( !find( level ) && !startLoad( level, distance ) ) {
+            break;
+        }
+    }
 }
 
-Board* BoardPool::getRecyclableBoard()
+Board* BoardPool::getRecyclableBoard( int minDistance )
 {
-    if ( mPool.size() < mTotalSize ) {
+    if ( mPool.size() + mLoading.size() < mTotalSize ) {
         auto board = new Board( this );
         QObject::connect( board, &Board::boardLoaded, this, &BoardPool::onBoardLoaded, Qt::QueuedConnection );
         return board;
@@ -155,7 +201,7 @@ Board* BoardPool::getRecyclableBoard()
         }
     }
 
-    if ( furthestLevel ) {
+    if ( furthestLevel && furthestDistance > minDistance ) {
         Board* board = mPool[furthestLevel];
         if ( mPool.erase( furthestLevel ) ) {
             return board;
@@ -163,15 +209,3 @@ Board* BoardPool::getRecyclableBoard()
     }
     return nullptr;
 }
-
-
-void PoolLoadRunnable::load(int level, Board *board)
-{
-    if ( GameRegistry* registry = getRegistry(board) ) {
-        Q_ASSERT( mBoard == nullptr );
-        mBoard = board;
-        mLevel = level;
-        emit board->boardLoading( level );
-        registry->getWorker().doWork( this );
-    }
-}
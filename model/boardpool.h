@@ -2,6 +2,7 @@
 #define BOARDPOOL_H
 
 #include <map>
+#include <memory>
 #include <QObject>
 
 #include "model/board.h"
@@ -10,6 +11,11 @@ class LevelList;
 
 class PoolLoadRunnable;
 
+/**
+ * @brief A pool of loaded boards tracking a window of visible levels.
+ * Boards are loaded concurrently on the worker pool. Once scrolling in a consistent direction, the pool prefetches the
+ * levels ahead of the visible window into its spare capacity.
+ */
 class BoardPool : public QObject
 {
     Q_OBJECT
@@ -45,16 +51,43 @@ signals:
 
 protected:
     std::map<int,Board*> mPool;
+    std::map<int,std::shared_ptr<PoolLoadRunnable>> mLoading;
     int mFirstVisible;
     int mVisibleCount;
 
 private:
     int ensureWithinVisible( int level );
-    Board* getRecyclableBoard();
+
+    /**
+     * @brief Get a board to load into; either a new board if under capacity or the board furthest from the visible window
+     * @param minDistance Only recycle boards further than this many levels from the visible window
+     * @return The board or nullptr if none available
+     */
+    Board* getRecyclableBoard( int minDistance = 0 );
+
+    /**
+     * @brief Start loading the given level if not already loading and there is loading capacity
+     * @param level The level to load
+     * @param minDistance Passed to getRecyclableBoard
+     * @return true if the level is now loading
+     */
+    bool startLoad( int level, int minDistance = 0 );
+
+    /**
+     * @brief Query whether another load can be started
+     */
+    bool canStartLoad() const;
+
+    /**
+     * @brief Load levels ahead of the visible window when the scroll direction has been established
+     */
+    void prefetch();
 
     unsigned mTotalSize;
     int mSize;
-    PoolLoadRunnable* mRunnable;
+    LevelList* mLevelList;
+    int mScrollDirection;
+    bool mScrollDirectionConfirmed;
 };
 
 #endif // BOARDPOOL_H
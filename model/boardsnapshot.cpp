@@ -0,0 +1,91 @@
+#include <algorithm>
+
+#include "boardsnapshot.h"
+
+unsigned long BoardSnapshot::getVersion() const
+{
+    return mVersion;
+}
+
+int BoardSnapshot::getLevel() const
+{
+    return mLevel;
+}
+
+const ModelPoint& BoardSnapshot::getLowerRight() const
+{
+    return mLowerRight;
+}
+
+const ModelPoint& BoardSnapshot::getFlagPoint() const
+{
+    return mFlagPoint;
+}
+
+int BoardSnapshot::getLastPushId() const
+{
+    return mLastPushId;
+}
+
+TileType BoardSnapshot::tileAt( const ModelPoint& point ) const
+{
+    return (point.mCol >= 0 && point.mRow >= 0
+         && point.mCol <= mLowerRight.mCol && point.mRow <= mLowerRight.mRow)
+      ? static_cast<TileType>( (*mRows[point.mRow])[point.mCol] ) : EMPTY;
+}
+
+PieceType BoardSnapshot::pieceAt( const ModelPoint& point, int* angle ) const
+{
+    int offset = point.mRow*PieceMaxRowCount + point.mCol;
+    auto it = std::lower_bound( mPieces->begin(), mPieces->end(), offset,
+                                []( const SnapshotPiece& piece, int offset ) { return piece.mOffset < offset; } );
+    if ( it != mPieces->end() && it->mOffset == offset ) {
+        if ( angle ) {
+            *angle = it->mAngle;
+        }
+        return it->mType;
+    }
+    return NONE;
+}
+
+int BoardSnapshot::pieceCount() const
+{
+    return static_cast<int>( mPieces->size() );
+}
+
+bool BoardSnapshot::sharesRow( int row, const BoardSnapshot& other ) const
+{
+    return row >= 0 && row < static_cast<int>(mRows.size()) && row < static_cast<int>(other.mRows.size())
+        && mRows[row] == other.mRows[row];
+}
+
+bool BoardSnapshot::sharesPieces( const BoardSnapshot& other ) const
+{
+    return mPieces == other.mPieces;
+}
+
+// FNV-1a
+constexpr std::uint64_t HashBasis = 14695981039346656037ULL;
+constexpr std::uint64_t HashPrime = 1099511628211ULL;
+
+static std::uint64_t hashInt( std::uint64_t hash, int value )
+{
+    for( int i = 0; i < 4; ++i, value >>= 8 ) {
+        hash = (hash ^ (value & 0xff)) * HashPrime;
+    }
+    return hash;
+}
+
+std::uint64_t BoardSnapshot::getHash() const
+{
+    std::uint64_t hash = hashInt( hashInt( HashBasis, mLowerRight.mCol ), mLowerRight.mRow );
+    for( const auto& row : mRows ) {
+        for( unsigned char tile : *row ) {
+            hash = (hash ^ tile) * HashPrime;
+        }
+    }
+    for( const auto& piece : *mPieces ) {
+        hash = hashInt( hashInt( hashInt( hash, piece.mOffset ), piece.mType ), piece.mAngle );
+    }
+    return hash;
+}
@@ -0,0 +1,109 @@
+#ifndef BOARDSNAPSHOT_H
+#define BOARDSNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tile.h"
+#include "modelpoint.h"
+#include "piece.h"
+
+class Board;
+
+/**
+ * @brief An immutable copy of a board's tiles and pieces at a given version.
+ * Snapshots are published by Board::getSnapshot and are shared by reference. Unchanged tile rows and an unchanged
+ * piece list are shared with the board's previous snapshot. Since a snapshot never changes once published, it can be
+ * read from any thread without locking.
+ */
+class BoardSnapshot
+{
+public:
+    /**
+     * @brief The board change count this snapshot reflects
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * @brief Get the level number of the board at the time of the snapshot
+     */
+    int getLevel() const;
+
+    /**
+     * @brief Get the maximum point on the board
+     */
+    const ModelPoint& getLowerRight() const;
+
+    /**
+     * @brief Get the location of the flag
+     */
+    const ModelPoint& getFlagPoint() const;
+
+    /**
+     * @brief Get the identifier of the most recent push at the time of the snapshot
+     */
+    int getLastPushId() const;
+
+    /**
+     * @brief Query what the given square is
+     * @param point The square of interest
+     * @return The type of square, or EMPTY if outside the board
+     */
+    TileType tileAt( const ModelPoint& point ) const;
+
+    /**
+     * @brief Query the piece at the given square
+     * @param point The square of interest
+     * @param angle If non-null and a piece is found, returns the piece's rotation
+     * @return The type of piece at the given square, or NONE if not found
+     */
+    PieceType pieceAt( const ModelPoint& point, int* angle = nullptr ) const;
+
+    /**
+     * @brief Query the number of pieces
+     */
+    int pieceCount() const;
+
+    /**
+     * @brief Query whether the given row is shared with another snapshot (i.e. unchanged between the two)
+     */
+    bool sharesRow( int row, const BoardSnapshot& other ) const;
+
+    /**
+     * @brief Query whether the piece list is shared with another snapshot (i.e. unchanged between the two)
+     */
+    bool sharesPieces( const BoardSnapshot& other ) const;
+
+    /**
+     * @brief Compute a hash of the board's playable state (i.e. its tiles and pieces). Push identifiers are not included,
+     * so equal states reached by different pushes hash the same.
+     */
+    std::uint64_t getHash() const;
+
+private:
+    typedef std::vector<unsigned char> TileRow;
+
+    typedef struct {
+        int mOffset; // row*BoardMaxWidth + col
+        PieceType mType;
+        int mAngle;
+        int mPushedId;
+    } SnapshotPiece;
+
+    typedef std::vector<SnapshotPiece> SnapshotPieces;
+
+    BoardSnapshot() = default;
+
+    unsigned long mVersion;
+    int mLevel;
+    ModelPoint mLowerRight;
+    ModelPoint mFlagPoint;
+    int mLastPushId;
+    std::vector<std::shared_ptr<const TileRow>> mRows;
+    std::shared_ptr<const SnapshotPieces> mPieces;
+
+    friend class Board;
+};
+
+#endif // BOARDSNAPSHOT_H
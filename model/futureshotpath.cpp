@@ -1,18 +1,15 @@
+#include <algorithm>
 #include <iostream>
 #include <QPainterPath>
 
 #include "futureshotpath.h"
+#include "board.h"
 #include "controller/game.h"
 #include "util/gameutils.h"
 
 FutureShotPath::FutureShotPath( MovePiece* move ) : mShotCount(0), mTailPoint(*move), mLeadVector(*move),
   mUID(move->getShotPathUID()), mPainterPath(nullptr)
 {
-    if ( !mUID ) {
-        static int lastUID = 0;
-        move->setShotPathUID(++lastUID);
-        mUID = lastUID;
-    }
 }
 
 FutureShotPath::FutureShotPath( const FutureShotPath& source ) : mShotCount(source.mShotCount),
@@ -66,7 +63,7 @@ FutureShotPath &FutureShotPath::operator =( const FutureShotPath &other )
     return *this;
 }
 
-const QPainterPath* FutureShotPath::toQPath()
+const QPainterPath* FutureShotPath::toQPath() const
 {
     if ( !mPainterPath ) {
         mPainterPath = new QPainterPath();
@@ -92,9 +89,78 @@ const QPainterPath* FutureShotPath::toQPath()
     return mPainterPath;
 }
 
+// the dimensions of the spatial index in cells
+constexpr int ShotIndexCols = (BoardMaxWidth  + ShotIndexCellSize - 1) / ShotIndexCellSize;
+constexpr int ShotIndexRows = (BoardMaxHeight + ShotIndexCellSize - 1) / ShotIndexCellSize;
+
+FutureShotPathManager::FutureShotPathManager() : mCells(ShotIndexCols*ShotIndexRows), mLastUID{0}
+{
+}
+
 void FutureShotPathManager::reset()
 {
     mPaths.clear();
+    for( auto& cell : mCells ) {
+        cell.clear();
+    }
+}
+
+void FutureShotPathManager::index( const FutureShotPath* path, bool add )
+{
+    // visit the cells crossed by each straight segment of the path
+    const ModelPoint* from = &path->mTailPoint;
+    for( unsigned bend = 0; bend <= path->mBendPoints.size(); ++bend ) {
+        const ModelPoint* to = (bend < path->mBendPoints.size()) ? &path->mBendPoints[bend] : &path->mLeadVector;
+        ModelPoint min = *from;
+        ModelPoint max = *from;
+        to->minMax( min, max );
+        int minCol = std::max( min.mCol / ShotIndexCellSize, 0 );
+        int minRow = std::max( min.mRow / ShotIndexCellSize, 0 );
+        int maxCol = std::min( max.mCol / ShotIndexCellSize, ShotIndexCols-1 );
+        int maxRow = std::min( max.mRow / ShotIndexCellSize, ShotIndexRows-1 );
+        for( int row = minRow; row <= maxRow; ++row ) {
+            for( int col = minCol; col <= maxCol; ++col ) {
+                std::vector<const FutureShotPath*>& cell = mCells[row*ShotIndexCols + col];
+                if ( add ) {
+                    if ( cell.empty() || cell.back() != path ) {
+                        cell.push_back( path );
+                    }
+                } else {
+                    cell.erase( std::remove( cell.begin(), cell.end(), path ), cell.end() );
+                }
+            }
+        }
+        from = to;
+    }
+}
+
+void FutureShotPathManager::getPathsIn( const QRect& rect, std::vector<const FutureShotPath*>& paths ) const
+{
+    paths.clear();
+    if ( mPaths.empty() ) {
+        return;
+    }
+
+    // allow for the pixel margin around the paths' squares
+    QRect area = rect.adjusted( -1, -1, 1, 1 );
+    ModelPoint min( area.topLeft() );
+    ModelPoint max( area.bottomRight() );
+    int minCol = std::max( min.mCol / ShotIndexCellSize, 0 );
+    int minRow = std::max( min.mRow / ShotIndexCellSize, 0 );
+    int maxCol = std::min( max.mCol / ShotIndexCellSize, ShotIndexCols-1 );
+    int maxRow = std::min( max.mRow / ShotIndexCellSize, ShotIndexRows-1 );
+    for( int row = minRow; row <= maxRow; ++row ) {
+        for( int col = minCol; col <= maxCol; ++col ) {
+            const std::vector<const FutureShotPath*>& cell = mCells[row*ShotIndexCols + col];
+            paths.insert( paths.end(), cell.begin(), cell.end() );
+        }
+    }
+
+    // paint in the same order as the whole set would be
+    std::sort( paths.begin(), paths.end(), []( const FutureShotPath* l, const FutureShotPath* r ) {
+        return l->getUID() < r->getUID();
+    } );
+    paths.erase( std::unique( paths.begin(), paths.end() ), paths.end() );
 }
 
 void FutureShotPathManager::invalidate( const FutureShotPath& path )
@@ -105,12 +171,16 @@ void FutureShotPathManager::invalidate( const FutureShotPath& path )
 const FutureShotPath* FutureShotPathManager::updateShots( int previousCount, MovePiece* move )
 {
     if ( GameRegistry* registry = getRegistry(this) ) {
+        if ( !move->getShotPathUID() ) {
+            move->setShotPathUID( ++mLastUID );
+        }
         FutureShotPath path(move);
         auto it = mPaths.find( path );
         Board* board = registry->getGame().getBoard(true);
         if ( it != mPaths.end() ) {
             board->undoChanges( previousCount, it->mChanges );
             emit dirtyRect( it->getBounds() );
+            index( &*it, false );
             mPaths.erase( it );
         }
 
@@ -127,7 +197,9 @@ const FutureShotPath* FutureShotPathManager::updateShots( int previousCount, Mov
         ModelVector leadVector( path.mLeadVector );
         unsigned maxBends = board->getWidth() + board->getHeight();
 
+        int steps = 0;
         while( path.mShotCount < newCount ) {
+            ++steps;
             path.mLeadVector = leadVector;
             if ( !getAdjacentPosition( leadVector.mAngle, &leadVector ) ) {
                 break;
@@ -172,12 +244,14 @@ const FutureShotPath* FutureShotPathManager::updateShots( int previousCount, Mov
         }
         path.mLeadVector = leadVector;
         path.mShotCount = newCount;
+        registry->getPerfStats().record( PerfStats::ShotTraceSteps, steps );
 
         path.initBounds();
         invalidate( path );
 
         std::pair<std::set<FutureShotPath>::iterator,bool> ret = mPaths.insert( path );
         if ( ret.second ) {
+            index( &*ret.first, true );
             return &(*ret.first);
         }
     }
@@ -196,6 +270,7 @@ void FutureShotPathManager::removePath( Piece* piece, bool undo )
                     registry->getGame().getBoard(true)->undoChanges( move->getShotCount(), it->mChanges );
                 }
             }
+            index( &*it, false );
             mPaths.erase( it );
             emit dirtyRect( bounds );
         }
@@ -19,8 +19,8 @@ class FutureShotPath
 {
 public:
     /**
-     * @brief Constructs a new instance and associates it with the given MovePiece via the unique identifier
-     * @param move The MovePiece to associate
+     * @brief Constructs an instance for the given MovePiece, identified by the move's shot path identifier
+     * @param move The MovePiece to associate. Its identifier is assigned by FutureShotPathManager::updateShots.
      * If the move is already associated with an existing instance, then a copy is constructed (which is
      * suitable for use as a search key).
      */
@@ -42,9 +42,9 @@ public:
 
     /**
      * @brief toQPath
-     * @return A QPainterPath depicting this shot
+     * @return A QPainterPath depicting this shot. The path is built on first use and kept with this instance.
      */
-    const QPainterPath* toQPath();
+    const QPainterPath* toQPath() const;
 
     /**
      * @brief Get the rectangle that indicates the paint region that this instance occupies
@@ -66,7 +66,7 @@ private:
     int mUID;
     std::vector<FutureChange> mChanges;
     QRect mBounds;
-    QPainterPath* mPainterPath;
+    mutable QPainterPath* mPainterPath;
 
     friend struct FutureShotPathComparator;
     friend class FutureShotPathManager;
@@ -82,12 +82,20 @@ struct FutureShotPathComparator {
 
 typedef std::set<FutureShotPath, FutureShotPathComparator> FutureShotPathSet;
 
+// The number of squares across each cell of the shot path spatial index
+constexpr int ShotIndexCellSize = 8;
+
+/**
+ * @brief Manages the future shot paths of a move plan.
+ * The paths are indexed by the board cells their segments cross so that painting a small area only visits the paths
+ * which pass through it.
+ */
 class FutureShotPathManager : public QObject
 {
     Q_OBJECT
 
 public:
-    FutureShotPathManager() = default;
+    FutureShotPathManager();
 
     void reset();
 
@@ -96,6 +104,13 @@ public:
 
     const FutureShotPathSet& getPaths() const;
 
+    /**
+     * @brief Collect the paths which cross the given view area
+     * @param rect The view area of interest
+     * @param paths Receives the paths in identifier order. The result may include paths which pass near the area.
+     */
+    void getPathsIn( const QRect& rect, std::vector<const FutureShotPath*>& paths ) const;
+
     /**
      * @brief Cause a repaint of this path
      */
@@ -105,7 +120,11 @@ signals:
     void dirtyRect( const QRect& rect );
 
 private:
+    void index( const FutureShotPath* path, bool add );
+
     FutureShotPathSet mPaths;
+    std::vector<std::vector<const FutureShotPath*>> mCells; // the paths crossing each index cell, row major
+    int mLastUID; // identifiers are unique per manager so that games don't share state
 };
 
 #endif // FUTURESHOTPATH_H
@@ -90,25 +90,14 @@ public:
     {
     }
 
-    void run() override
+    const char* getName() const override
     {
-        QFile source( ":/maps/levels.xml" );
-        if ( source.open( QIODevice::ReadOnly ) ) {
-            QXmlSimpleReader xml;
-            LevelXmlHandler handler( mLevelList );
-            xml.setContentHandler( &handler );
-            QXmlInputSource xmlInputSource( &source );
-
-            if ( !xml.parse( xmlInputSource ) ) {
-                std::cout << "** error parsing " << qPrintable(source.fileName()) << ": " << qPrintable(handler.errorString()) << std::endl;
-            }
-        } else {
-            std::cout << "** couldn't' read " << qPrintable(source.fileName()) << std::endl;
-        }
-
-        mLevelList.mInitialized = true;
+        return "ListLoadRunnable";
+    }
 
-        emit mLevelList.initialized();
+    void run() override
+    {
+        mLevelList.load();
     }
 
     bool deleteWhenDone() override
@@ -131,6 +120,26 @@ void LevelList::init( GameRegistry* registry )
     registry->getWorker().doWork( new ListLoadRunnable( *this ) );
 }
 
+void LevelList::load()
+{
+    QFile source( ":/maps/levels.xml" );
+    if ( source.open( QIODevice::ReadOnly ) ) {
+        QXmlSimpleReader xml;
+        LevelXmlHandler handler( *this );
+        xml.setContentHandler( &handler );
+        QXmlInputSource xmlInputSource( &source );
+
+        if ( !xml.parse( xmlInputSource ) ) {
+            std::cout << "** error parsing " << qPrintable(source.fileName()) << ": " << qPrintable(handler.errorString()) << std::endl;
+        }
+    } else {
+        std::cout << "** couldn't' read " << qPrintable(source.fileName()) << std::endl;
+    }
+
+    mInitialized = true;
+    emit initialized();
+}
+
 void LevelList::addLevel( int number, int width, int height )
 {
     mLevels.append( Level( number, width, height ) );
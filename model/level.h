@@ -56,6 +56,11 @@ public:
     LevelList();
     void init( GameRegistry* registry );
 
+    /**
+     * @brief Load the level definitions in the calling thread. init() does this in the background.
+     */
+    void load();
+
     int rowCount( const QModelIndex& ) const override;
     QVariant data( const QModelIndex& index, int role ) const override;
 
@@ -145,7 +150,6 @@ private:
     QSize mVisualSizeHint;
 
     friend class LevelXmlHandler;
-    friend class ListLoadRunnable;
 };
 
 #endif // LEVEL_H
@@ -19,40 +19,18 @@ void MoveListManager::setInitialFocus( PieceType initialFocus )
 
 MovePiece* MoveListManager::append( PieceType type, const ModelPoint& point, int angle, int shotCount, const Piece* pushPiece )
 {
-    auto move = new MovePiece( type, point, angle, shotCount, pushPiece );
-    addInternal( move );
-    return move;
+    return addInternal( MovePiece( type, point, angle, shotCount, pushPiece ) );
 }
 
 MovePiece* MoveListManager::append( PieceType type, const ModelVector& vector, int shotCount, const Piece* pushPiece )
 {
-    auto move = new MovePiece( type, vector, shotCount, pushPiece );
-    addInternal( move );
-    return move;
+    return addInternal( MovePiece( type, vector, shotCount, pushPiece ) );
 }
 
 MovePiece* MoveListManager::setShotCountBack( int count )
 {
     if ( !mPieces.empty() ) {
-        auto it = mPieces.end();
-        Piece* piece = *--it;
-        auto move = dynamic_cast<MovePiece*>(piece);
-        if ( !move ) {
-            move = new MovePiece( piece );
-            mPieces.erase( it );
-            delete piece;
-            mPieces.push_back( move );
-
-            // purge any cached sets given they are now stale:
-            if ( mSet ) {
-                delete mSet;
-                mSet = nullptr;
-            }
-            if ( mMultiSet ) {
-                delete mMultiSet;
-                mMultiSet = nullptr;
-            }
-        }
+        MovePiece* move = &mPieces.back();
         if ( move->setShotCount( count ) ) {
             emit changedAt( *move );
         }
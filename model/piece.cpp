@@ -6,6 +6,7 @@ MovePiece::MovePiece( const Piece* source ) : SimplePiece(source)
 {
     mShotCount = source->getShotCount();
     mPreviousPushedId = source->getPreviousPushedId();
+    mPushedId = source->getPushedId();
 
     if ( source->hasPush() || mShotCount )
         if ( auto pusherSource = dynamic_cast<const MovePiece*>(source) ) {
@@ -45,6 +46,11 @@ int MovePiece::getPreviousPushedId() const
     return mPreviousPushedId;
 }
 
+int MovePiece::getPushedId() const
+{
+    return mPushedId;
+}
+
 bool MovePiece::setShotCount( int count )
 {
     if ( count != mShotCount ) {
@@ -77,8 +83,3 @@ bool SimplePiece::hasPush() const
 {
     return false;
 }
-
-int Piece::encodedPos() const
-{
-    return encodePos( mCol, mRow );
-}
@@ -3,8 +3,9 @@
 
 #include <QObject>
 #include <qmetatype.h>
-#include <list>
+#include <deque>
 #include <set>
+#include <vector>
 
 #include "pieceview.h"
 
@@ -55,7 +56,10 @@ public:
      * @brief Retrieve the search term for this piece
      * @return The encoded position value
      */
-    int encodedPos() const;
+    int encodedPos() const
+    {
+        return encodePos( mCol, mRow );
+    }
 
     virtual bool hasPush() const override = 0;
     virtual int getShotCount() const override = 0;
@@ -117,7 +121,12 @@ public:
     }
 };
 
-class PushedPiece : public SimplePiece
+/**
+ * @brief A board piece record. Board pieces are held by value in this form (see PieceVector).
+ * Being final, calls made through a PushedPiece resolve without virtual dispatch. Records are still Pieces, so each
+ * carries a vtable pointer; they are not plain data.
+ */
+class PushedPiece final : public SimplePiece
 {
 public:
     PushedPiece( const Piece* piece, int pushedId = 0 ) : SimplePiece(piece), mPushedId(pushedId ? pushedId : piece->getPushedId())
@@ -149,7 +158,7 @@ public:
           mPushPieceType( pushPiece ? pushPiece->mType  : NONE),
           mPushPieceAngle(pushPiece ? pushPiece->mAngle : 0),
           mShotCount(shotCount), mShotPathUID(0),
-          mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 )
+          mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 ), mPushedId(0)
     {
     }
 
@@ -158,7 +167,7 @@ public:
         mPushPieceType( pushPiece ? pushPiece->mType  : NONE),
         mPushPieceAngle(pushPiece ? pushPiece->mAngle : 0),
         mShotCount(shotCount), mShotPathUID(0),
-        mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 )
+        mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 ), mPushedId(0)
     {
     }
 
@@ -167,7 +176,7 @@ public:
         mPushPieceType( pushPiece ? pushPiece->mType  : NONE),
         mPushPieceAngle(pushPiece ? pushPiece->mAngle : 0),
         mShotCount(shotCount), mShotPathUID(0),
-        mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 )
+        mPreviousPushedId(pushPiece ? pushPiece->getPushedId() : 0 ), mPushedId(0)
     {
     }
 
@@ -187,6 +196,11 @@ public:
      */
     int getPreviousPushedId() const override;
 
+    /**
+     * @brief Get the pushId of the piece this move was copied from, if any
+     */
+    int getPushedId() const override;
+
     /**
      * @brief Set the count of future shots for this move point
      */
@@ -216,6 +230,7 @@ private:
     int mShotCount;
     int mShotPathUID;
     int mPreviousPushedId;
+    int mPushedId;
 };
 
 // comparator used by the stl
@@ -227,7 +242,8 @@ struct PieceSetComparator {
 };
 
 // stl container types used for pieces
-typedef std::list<Piece*> PieceList;
+typedef std::deque<MovePiece> PieceDeque;    // held by value; references stay valid while adding/removing at the ends
+typedef std::vector<PushedPiece> PieceVector; // contiguous records sorted by encoded position
 typedef std::set<Piece*,PieceSetComparator> PieceSet;
 typedef std::multiset<Piece*,PieceSetComparator> PieceMultiSet;
 
@@ -1,19 +1,15 @@
 #include "piecelistmanager.h"
 
-PieceListManager::PieceListManager( QObject *parent ) : PieceManager(parent), mSet{nullptr}, mMultiSet{nullptr}
+PieceListManager::PieceListManager( QObject *parent ) : PieceManager(parent), mSet{nullptr}
 {
 }
 
 PieceListManager::~PieceListManager()
 {
     delete mSet;
-    delete mMultiSet;
-    for( auto it : mPieces ) {
-        delete it;
-    }
 }
 
-const PieceList& PieceListManager::getList() const
+const PieceDeque& PieceListManager::getList() const
 {
     return mPieces;
 }
@@ -22,139 +18,149 @@ const PieceSet* PieceListManager::toSet()
 {
     if ( !mSet ) {
         mSet = new PieceSet;
-        for( auto iterator : mPieces ) {
-            mSet->insert( iterator );
+        for( auto& piece : mPieces ) {
+            mSet->insert( &piece );
         }
     }
     return mSet;
 }
 
-const PieceMultiSet* PieceListManager::toMultiSet()
+const PieceMultiSet* PieceListManager::toMultiSet() const
 {
-    if ( !mMultiSet ) {
-        mMultiSet = new PieceMultiSet;
-        for( auto iterator : mPieces ) {
-            mMultiSet->insert( iterator );
-        }
-    }
-    return mMultiSet;
+    return &mIndex;
 }
 
-Piece* PieceListManager::addInternal( Piece* piece , bool pushFront )
+MovePiece* PieceListManager::addInternal( const MovePiece& piece, bool pushFront )
 {
+    MovePiece* added;
     if ( pushFront ) {
         mPieces.push_front( piece );
+        added = &mPieces.front();
     } else {
         mPieces.push_back( piece );
+        added = &mPieces.back();
     }
+    mIndex.insert( added );
     if ( mSet ) {
-        mSet->insert( piece );
+        mSet->insert( added );
     }
-    if ( mMultiSet ) {
-        mMultiSet->insert( piece );
-    }
-    emit insertedAt( *piece );
-    return piece;
+    emit insertedAt( *added );
+    return added;
 }
 
 Piece* PieceListManager::append( PieceType type, const ModelVector& vector )
 {
-    return addInternal( new SimplePiece( type, vector ) );
+    return addInternal( MovePiece( type, vector ) );
 }
 
 Piece* PieceListManager::append( PieceType type, const ModelPoint& point, int angle )
 {
-    return addInternal( new SimplePiece( type, point, angle ) );
+    return addInternal( MovePiece( type, point, angle ) );
 }
 
 Piece* PieceListManager::append( const Piece* source )
 {
     if ( auto move = dynamic_cast<const MovePiece*>(source) ) {
-        return addInternal( new MovePiece(move) );
+        return addInternal( *move );
     }
-    return addInternal( source->getPushedId() > 0 ? (new PushedPiece(source)) : (new SimplePiece(source)) );
+    return addInternal( MovePiece( source ) );
 }
 
-void PieceListManager::appendList( const PieceList& source )
+void PieceListManager::appendList( const PieceDeque& source )
 {
-    for( auto it : source ) {
-        append( it );
+    for( const auto& piece : source ) {
+        addInternal( piece );
     }
 }
 
 Piece* PieceListManager::push_front( PieceType type, const ModelVector& vector, int shotCount, const Piece* pushPiece )
 {
-    return addInternal( new MovePiece( type, vector, shotCount, pushPiece ), true );
+    return addInternal( MovePiece( type, vector, shotCount, pushPiece ), true );
 }
 
-bool PieceListManager::eraseInternal( PieceList::iterator it )
+void PieceListManager::unindex( Piece* piece )
 {
-    if ( it == mPieces.end() ) {
-        return false;
-    }
-
-    Piece* piece = *it;
-    ModelPoint point = *piece;
-
-    mPieces.erase( it );
-
     if ( mSet ) {
         mSet->erase( piece );
     }
 
-    if ( mMultiSet ) {
-        auto pair = mMultiSet->equal_range( piece );
-        for( auto sit = pair.first; sit != pair.second; ++sit ) {
-            if ( *sit == piece ) {
-                mMultiSet->erase(sit);
-                break;
-            }
+    auto pair = mIndex.equal_range( piece );
+    for( auto it = pair.first; it != pair.second; ++it ) {
+        if ( *it == piece ) {
+            mIndex.erase( it );
+            break;
         }
     }
-
-    delete piece;
-    emit erasedAt( point );
-    return true;
 }
 
 bool PieceListManager::eraseFront()
 {
-    return eraseInternal( mPieces.begin() );
+    if ( !mPieces.empty() ) {
+        ModelPoint point = mPieces.front();
+        unindex( &mPieces.front() );
+        mPieces.pop_front();
+        emit erasedAt( point );
+        return true;
+    }
+    return false;
 }
 
-Piece* PieceListManager::getBack() const
+Piece* PieceListManager::getBack()
 {
     if ( mPieces.empty() ) {
         return nullptr;
     }
-    return mPieces.back();
+    return &mPieces.back();
 }
 
-Piece* PieceListManager::getBack( int index ) const
+const Piece* PieceListManager::getBack() const
+{
+    if ( mPieces.empty() ) {
+        return nullptr;
+    }
+    return &mPieces.back();
+}
+
+Piece* PieceListManager::getBack( int index )
+{
+    if ( 0 <= index && static_cast<unsigned>(index) < mPieces.size() ) {
+        return &mPieces[mPieces.size() - 1 - index];
+    }
+    return nullptr;
+}
+
+const Piece* PieceListManager::getBack( int index ) const
 {
     if ( 0 <= index && static_cast<unsigned>(index) < mPieces.size() ) {
-        auto it = mPieces.cend();
-        do {
-            --it;
-        } while( --index >= 0 );
-        return *it;
+        return &mPieces[mPieces.size() - 1 - index];
     }
     return nullptr;
 }
 
-Piece* PieceListManager::getFront() const
+Piece* PieceListManager::getFront()
 {
     if ( mPieces.empty() ) {
         return nullptr;
     }
-    return mPieces.front();
+    return &mPieces.front();
+}
+
+const Piece* PieceListManager::getFront() const
+{
+    if ( mPieces.empty() ) {
+        return nullptr;
+    }
+    return &mPieces.front();
 }
 
 bool PieceListManager::eraseBack()
 {
     if ( !mPieces.empty() ) {
-        auto it = mPieces.end();
-        return eraseInternal( --it );
+        ModelPoint point = mPieces.back();
+        unindex( &mPieces.back() );
+        mPieces.pop_back();
+        emit erasedAt( point );
+        return true;
     }
     return false;
 }
@@ -171,7 +177,7 @@ void PieceListManager::replaceInternal( Piece* piece, PieceType type, int newAng
 bool PieceListManager::replaceFront( PieceType type, int newAngle )
 {
     if ( !mPieces.empty() ) {
-        replaceInternal( mPieces.front(), type, newAngle );
+        replaceInternal( &mPieces.front(), type, newAngle );
         return true;
     }
     return false;
@@ -180,7 +186,7 @@ bool PieceListManager::replaceFront( PieceType type, int newAngle )
 bool PieceListManager::replaceBack( PieceType type, int newAngle )
 {
     if ( !mPieces.empty() ) {
-        replaceInternal( mPieces.back(), type, newAngle );
+        replaceInternal( &mPieces.back(), type, newAngle );
         return true;
     }
     return false;
@@ -191,13 +197,11 @@ void PieceListManager::reset( PieceListManager* source, bool copy )
     while( eraseBack() ) {
         // continue
     }
-    // clear any sets for safety (shouldn't be necessary):
+    // clear the indexes for safety (shouldn't be necessary):
+    mIndex.clear();
     if ( mSet ) {
         mSet->clear();
     }
-    if ( mMultiSet ) {
-        mMultiSet->clear();
-    }
 
     if ( source ) {
         appendList( source, copy );
@@ -206,14 +210,13 @@ void PieceListManager::reset( PieceListManager* source, bool copy )
 
 void PieceListManager::appendList( PieceListManager* source, bool copy )
 {
-    PieceList& list = source->mPieces;
-    for( auto it = list.begin(); it != list.end(); ) {
-        if ( !copy ) {
-            addInternal( *it );
-            it = list.erase( it );
-        } else {
-            append( *it );
-            ++it;
+    appendList( source->mPieces );
+    if ( !copy ) {
+        // the pieces now belong to this list; empty the source without notifying
+        source->mPieces.clear();
+        source->mIndex.clear();
+        if ( source->mSet ) {
+            source->mSet->clear();
         }
     }
 }
@@ -7,6 +7,8 @@
 
 /**
  * @brief A manager for piece lists
+ * The pieces are held by value in a deque, so indexed access is constant time. A position ordered index of the pieces
+ * is kept up to date as pieces are added and removed.
  */
 class PieceListManager : public PieceManager
 {
@@ -19,7 +21,7 @@ public:
     /**
      * @brief Get the underlying list being managed
      */
-    const PieceList& getList() const;
+    const PieceDeque& getList() const;
 
     /**
      * @brief Get this list in the form of a set
@@ -30,9 +32,9 @@ public:
 
     /**
      * @brief Get this list in the form of a multiset
-     * @return The multiset of pieces
+     * @return The multiset of pieces, ordered by position
      */
-    const PieceMultiSet* toMultiSet();
+    const PieceMultiSet* toMultiSet() const;
 
     /**
      * @brief Adds a new piece to the end of this list from the given values
@@ -50,12 +52,12 @@ public:
      * @brief Copy elements from source into the end of this list
      * @param source The pieces to append
      */
-    void appendList( const PieceList& source );
+    void appendList( const PieceDeque& source );
 
     /**
      * @brief Copy or move pieces from source to the end of this list
      * @param source The manager containing the source pieces
-     * @param copy If true, allocates and appends new copies from source. If false, instances are transferred
+     * @param copy If true, source is left intact, otherwise source is emptied
      */
     void appendList( PieceListManager* source, bool copy = true );
 
@@ -68,20 +70,23 @@ public:
      * @brief get the first element
      * @return the last element in the list, or 0 if empty
      */
-    Piece* getFront() const;
+    Piece* getFront();
+    const Piece* getFront() const;
 
     /**
      * @brief get the last element
      * @return the last element in the list, or 0 if empty
      */
-    Piece* getBack() const;
+    Piece* getBack();
+    const Piece* getBack() const;
 
     /**
      * @brief Get the nth piece from the back of the list
      * @param index The reverse offset of the piece from the back of the list
      * @return The selected piece or 0 if not present
      */
-    Piece* getBack( int index ) const;
+    Piece* getBack( int index );
+    const Piece* getBack( int index ) const;
 
     /**
      * @brief removes the first element
@@ -122,13 +127,13 @@ public slots:
     void reset( PieceListManager* source = nullptr, bool copy = true );
 
 protected:
-    Piece* addInternal( Piece* piece, bool pushFront = false );
-    bool eraseInternal( PieceList::iterator it );
+    MovePiece* addInternal( const MovePiece& piece, bool pushFront = false );
+    void unindex( Piece* piece );
     void replaceInternal( Piece* piece, PieceType type, int newAngle );
 
-    PieceList mPieces;
+    PieceDeque mPieces;
+    PieceMultiSet mIndex;
     PieceSet* mSet;
-    PieceMultiSet* mMultiSet;
 };
 
 #endif // PIECELISTMANAGER_H
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "piecesetmanager.h"
 
 PieceSetManager::PieceSetManager( QObject* parent ) : PieceManager(parent)
@@ -6,19 +8,32 @@ PieceSetManager::PieceSetManager( QObject* parent ) : PieceManager(parent)
 
 PieceSetManager::~PieceSetManager()
 {
-    for( auto it : mPieces ) {
-        delete it;
-    }
 }
 
-const PieceSet& PieceSetManager::getPieces() const
+const PieceVector& PieceSetManager::getPieces() const
 {
     return mPieces;
 }
 
+PieceVector::iterator PieceSetManager::lowerBound( int encodedPos )
+{
+    return std::lower_bound( mPieces.begin(), mPieces.end(), encodedPos,
+                             []( const PushedPiece& piece, int pos ) { return piece.encodedPos() < pos; } );
+}
+
+PieceVector::const_iterator PieceSetManager::lowerBound( int encodedPos ) const
+{
+    return std::lower_bound( mPieces.cbegin(), mPieces.cend(), encodedPos,
+                             []( const PushedPiece& piece, int pos ) { return piece.encodedPos() < pos; } );
+}
+
 void PieceSetManager::insert( PieceType type, const ModelPoint& point, int angle, int pushedId )
 {
-    mPieces.insert( pushedId ? (new PushedPiece( type, point, angle, pushedId)) : (new SimplePiece( type, point, angle )) );
+    int pos = Piece::encodePos( point.mCol, point.mRow );
+    auto it = lowerBound( pos );
+    if ( it == mPieces.end() || it->encodedPos() != pos ) {
+        mPieces.insert( it, PushedPiece( type, point, angle, pushedId ) );
+    }
     emit insertedAt( point );
 }
 
@@ -29,33 +44,39 @@ void PieceSetManager::insert( Piece* piece )
 
 PieceType PieceSetManager::typeAt( const ModelPoint& point )
 {
-    SimplePiece pos( NONE, point );
-    auto it = mPieces.find( &pos );
-    if ( it != mPieces.end() ) {
-        return (*it)->getType();
+    if ( const Piece* piece = pieceAt( point ) ) {
+        return piece->getType();
     }
     return NONE;
 }
 
-Piece* PieceSetManager::pieceAt( const ModelPoint& point ) const
+Piece* PieceSetManager::pieceAt( const ModelPoint& point )
 {
-    SimplePiece pos( NONE, point );
-    auto it = mPieces.find( &pos );
-    if ( it != mPieces.end() ) {
-        return *it;
+    int pos = Piece::encodePos( point.mCol, point.mRow );
+    auto it = lowerBound( pos );
+    if ( it != mPieces.end() && it->encodedPos() == pos ) {
+        return &*it;
     }
     return nullptr;
 }
 
-bool PieceSetManager::erase( Piece* key )
+const Piece* PieceSetManager::pieceAt( const ModelPoint& point ) const
 {
-    auto it = mPieces.find( key );
-    if ( it != mPieces.end() ) {
-        Piece* piece = *it;
-        ModelPoint point = *piece;
+    int pos = Piece::encodePos( point.mCol, point.mRow );
+    auto it = lowerBound( pos );
+    if ( it != mPieces.cend() && it->encodedPos() == pos ) {
+        return &*it;
+    }
+    return nullptr;
+}
 
+bool PieceSetManager::erase( Piece* key )
+{
+    int pos = key->encodedPos();
+    auto it = lowerBound( pos );
+    if ( it != mPieces.end() && it->encodedPos() == pos ) {
+        ModelPoint point = *it;
         mPieces.erase( it );
-        delete piece;
 
         emit erasedAt( point );
         return true;
@@ -94,18 +115,15 @@ void PieceSetManager::setAt( PieceType type, const ModelPoint& point, int angle,
 void PieceSetManager::reset( const PieceSetManager* source )
 {
     while( !mPieces.empty() ) {
-        auto it = mPieces.end();
-        Piece* piece = *--it;
-        ModelPoint point = *piece;
-        mPieces.erase( it );
-        delete piece;
+        ModelPoint point = mPieces.back();
+        mPieces.pop_back();
         emit erasedAt( point );
     }
 
     if ( source != nullptr ) {
-        const PieceSet& sourceSet = source->getPieces();
-        for( auto it : sourceSet ) {
-            insert( it );
+        mPieces = source->mPieces;
+        for( unsigned i = 0; i < mPieces.size(); ++i ) {
+            emit insertedAt( mPieces[i] );
         }
     }
 }
@@ -117,10 +135,9 @@ int PieceSetManager::size() const
 
 void PieceSetManager::invalidatePushIdDelineation( int delineation )
 {
-    for( auto it : mPieces ) {
-        if ( it->getPushedId() > delineation ) {
-            emit changedAt( *it );
+    for( unsigned i = 0; i < mPieces.size(); ++i ) {
+        if ( mPieces[i].getPushedId() > delineation ) {
+            emit changedAt( mPieces[i] );
         }
     }
 }
-
@@ -7,6 +7,8 @@
 
 /**
  * @brief Manages a self-contained set of pieces
+ * The pieces are held contiguously by value, sorted by position. Pointers to pieces returned by this class remain
+ * valid only until the set is next changed.
  */
 class PieceSetManager : public PieceManager
 {
@@ -19,7 +21,7 @@ public:
     /**
      * @brief Get the underlying set being managed
      */
-    const PieceSet& getPieces() const;
+    const PieceVector& getPieces() const;
 
     /**
      * @brief Creates a new piece from the given values and adds it to this set
@@ -41,9 +43,11 @@ public:
     /**
      * @brief Searches for a piece in this set that has the given position
      * @param point position to search for
-     * @return The piece at the given position, or 0 if not found
+     * @return The piece at the given position, or 0 if not found. The piece is held in place, so the pointer is
+     * invalidated by any insert or erase on this set. Copy the piece before changing the set if it is still needed.
      */
-    Piece* pieceAt( const ModelPoint& point ) const;
+    Piece* pieceAt( const ModelPoint& point );
+    const Piece* pieceAt( const ModelPoint& point ) const;
 
     /**
      * @brief removes any piece from the set at the postion specified by key
@@ -83,7 +87,10 @@ public slots:
     void invalidatePushIdDelineation( int delineation );
 
 private:
-    PieceSet mPieces;
+    PieceVector::iterator lowerBound( int encodedPos );
+    PieceVector::const_iterator lowerBound( int encodedPos ) const;
+
+    PieceVector mPieces;
 };
 
 #endif // PIECESETMANAGER_H
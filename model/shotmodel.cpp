@@ -1,27 +1,44 @@
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include "shotmodel.h"
 #include "controller/game.h"
 #include "controller/animationstateaggregator.h"
 #include "controller/speedcontroller.h"
+#include "model/push.h"
 #include "view/shooter.h"
 #include "util/gameutils.h"
+#include "util/trace.h"
 
 // Runnable to measure the total length of the current shot.
-// Note its implementation uses a mutex to pass its result between threads.
+// The shot is traced over a snapshot of the master board so the board isn't read from the worker thread.
+// Note its implementation uses a mutex to pass its parameters and result between threads.
 //
 class MeasureRunnable : public BasicRunnable
 {
 public:
-    MeasureRunnable( ShotModel& model ) : mModel(model), mResult(0)
+    MeasureRunnable() : mRegistry(nullptr), mResult(0)
     {
     }
 
-    void startMeasurement( const ModelVector& startVector )
+    void startMeasurement( const ModelVector& startVector, GameRegistry* registry )
     {
-        if ( GameRegistry* registry = getRegistry(&mModel) ) {
+        if ( registry ) {
+            std::shared_ptr<const BoardSnapshot> snapshot = registry->getGame().getBoard()->getSnapshot();
+
+            // pieces in transit block the shot at their destination
+            std::vector<ModelPoint> blockedPoints;
+            for( Push* push : { &registry->getTankPush(), &registry->getShotPush() } ) {
+                if ( push->getType() != NONE ) {
+                    blockedPoints.push_back( push->getTargetPoint() );
+                }
+            }
+
             {   std::lock_guard<std::mutex> guard(mMutex);
                 mStartVector = startVector;
+                mRegistry = registry;
+                mSnapshot = snapshot;
+                mBlockedPoints.swap( blockedPoints );
                 mResult = 0;
             }
             registry->getWorker().doWork(this);
@@ -34,22 +51,35 @@ public:
         return startVector.equals( mStartVector ) ? mResult : 0;
     }
 
+    const char* getName() const override
+    {
+        return "MeasureRunnable";
+    }
+
     void run() final
     {
-        if ( GameRegistry* registry = getRegistry(&mModel) ) {
-            ModelVector curVector;
-            {   std::lock_guard<std::mutex> guard(mMutex);
-                curVector = mStartVector;
-            }
+        ModelVector curVector;
+        GameRegistry* registry;
+        std::shared_ptr<const BoardSnapshot> snapshot;
+        std::vector<ModelPoint> blockedPoints;
+        {   std::lock_guard<std::mutex> guard(mMutex);
+            curVector = mStartVector;
+            registry = mRegistry;
+            snapshot = mSnapshot;
+            blockedPoints = mBlockedPoints;
+        }
+        if ( registry && snapshot ) {
             ModelVector startVector( curVector );
-            Game& game = registry->getGame();
 
             int length = 0;
             while( getAdjacentPosition( curVector.mAngle, &curVector )
-              && game.canShootThru( curVector, &curVector.mAngle )
+              && Game::canShootThru( *snapshot, curVector, &curVector.mAngle )
+              && std::none_of( blockedPoints.begin(), blockedPoints.end(),
+                               [&curVector]( const ModelPoint& point ) { return point.equals( curVector ); } )
               && !curVector.ModelPoint::equals(startVector) /*prevent infinite circular path*/ ) {
                 ++length;
             }
+            registry->getPerfStats().record( PerfStats::ShotTraceSteps, length );
             if ( length ) {
                 std::lock_guard<std::mutex> guard(mMutex);
                 if ( mStartVector.equals(startVector) ) {
@@ -61,13 +91,15 @@ public:
 
 private:
     std::mutex mMutex;
-    ShotModel& mModel;
+    GameRegistry* mRegistry;
+    std::shared_ptr<const BoardSnapshot> mSnapshot;
+    std::vector<ModelPoint> mBlockedPoints;
     ModelVector mStartVector;
     int mResult;
 };
 
 ShotModel::ShotModel( QObject* parent ) : ShotView(parent), mLeadingDirection{0}, mDistance{0}, mShedding{false},
-  mKillSequence{0}, mLastStepNo{-1}, mDuration{-1}, mRunnable(new MeasureRunnable(*this))
+  mKillSequence{0}, mLastStepNo{-1}, mDuration{-1}, mRegistry{nullptr}, mRunnable(new MeasureRunnable())
 {
     QObject::connect( &mAnimation, &ShotAnimation::currentTimeChanged, this, &ShotModel::onTimeChanged, Qt::DirectConnection );
 }
@@ -108,14 +140,15 @@ bool ShotModel::fire( Shooter* shooter )
         mLeadingDirection = direction;
         mLeadingPoint = ModelPoint( shooter->getViewX().toInt()/24, shooter->getViewY().toInt()/24 );
         mStartVector = ModelVector( mLeadingPoint, direction );
-        if ( GameRegistry* registry = getRegistry(this) ) {
+        mRegistry = getRegistry(this);
+        if ( GameRegistry* registry = mRegistry ) {
             mDuration = registry->getSpeedController().getSpeed() - 30;
         } else {
             mDuration = SpeedController::NormalSpeed - 30;
         }
         commenceFire( shooter );
         mAnimation.start();
-        mRunnable->startMeasurement( mStartVector );
+        mRunnable->startMeasurement( mStartVector, mRegistry );
         return true;
     }
     return false;
@@ -130,7 +163,7 @@ void ShotModel::onTimeChanged( int currentTime )
         return;
     }
 
-    if ( GameRegistry* registry = getRegistry(this) ) {
+    if ( GameRegistry* registry = mRegistry ) {
         Game& game = registry->getGame();
 
         if ( mKillSequence ) {
@@ -148,6 +181,7 @@ void ShotModel::onTimeChanged( int currentTime )
             return;
         }
 
+        TRACE_SCOPE( "ShotModel::step" );
         bool hasTermination = hasTerminationPoint();
         do {
             if ( !hasTermination ) {
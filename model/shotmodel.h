@@ -7,6 +7,7 @@ class Game;
 class AnimationStateAggregator;
 class Shooter;
 class MeasureRunnable;
+class GameRegistry;
 
 #include "model/modelpoint.h"
 #include "view/shotview.h"
@@ -101,6 +102,7 @@ private:
     int mKillSequence;
     int mLastStepNo;
     int mDuration;
+    GameRegistry* mRegistry; // the context of the current shot
     MeasureRunnable* mRunnable;
 
     friend class MeasureRunnable;
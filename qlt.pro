@@ -8,8 +8,15 @@ QT += widgets
 
 QMAKE_CXXFLAGS += -std=gnu++11
 
+# qmake CONFIG+=trace compiles in the timeline trace zones (see util/trace.h)
+trace {
+    DEFINES += QLT_TRACE
+    SOURCES += util/trace.cpp
+}
+
 HEADERS += \
     model/board.h \
+    model/boardsnapshot.h \
     model/piece.h \
     model/piecesetmanager.h \
     model/piecelistmanager.h \
@@ -23,10 +30,14 @@ HEADERS += \
     util/loadable.h \
     util/persistfile.h \
     model/movelistmanager.h \
-    util/helputils.h
+    util/helputils.h \
+    util/mapgenerator.h \
+    util/perfstats.h \
+    util/trace.h
 
 SOURCES += \
     model/board.cpp \
+    model/boardsnapshot.cpp \
     model/piece.cpp \
     model/piecesetmanager.cpp \
     model/piecelistmanager.cpp \
@@ -39,12 +50,18 @@ SOURCES += \
     util/persist.cpp \
     model/movelistmanager.cpp \
     util/helputils.cpp \
-    util/hexdump.cpp
+    util/hexdump.cpp \
+    util/mapgenerator.cpp \
+    util/perfstats.cpp
 
 index {
     TARGET = qltindexer
     SOURCES +=  index/indexermain.cpp
 }
+else:generator {
+    TARGET = qltgenerator
+    SOURCES +=  generator/generatormain.cpp
+}
 else {
 # definitions common to app & test
 
@@ -55,6 +72,7 @@ RESOURCES += qml.qrc
 HEADERS += \
     view/shooter.h \
     controller/speedcontroller.h \
+    controller/gameclock.h \
     model/shotmodel.h \
     view/shotview.h \
     controller/animationstateaggregator.h \
@@ -67,6 +85,8 @@ HEADERS += \
     controller/pathsearchcriteria.h \
     controller/pathsearchaction.h \
     controller/pathfinder/pathfinder.h \
+    controller/pathfinder/pushplanner.h \
+    controller/pathfinder/routesearch.h \
     model/futureshotpath.h \
     view/pushview.h \
     model/push.h \
@@ -78,6 +98,7 @@ HEADERS += \
     view/replaytext.h \
     util/workerthread.h \
     controller/gameinitializer.h \
+    controller/evalserver.h \
     controller/gameregistry.h \
     model/level.h \
     view/levelchooser.h \
@@ -85,11 +106,15 @@ HEADERS += \
     view/tiledragmarker.h \
     view/levelcompleteddialog.h \
     util/qltxmlhandler.h \
-    view/whatsthisaware.h
+    view/whatsthisaware.h \
+    view/repaintscheduler.h \
+    view/staticboardlayer.h \
+    view/thumbnailcache.h
 
 SOURCES += \
     view/shooter.cpp \
     controller/speedcontroller.cpp \
+    controller/gameclock.cpp \
     model/shotmodel.cpp \
     view/shotview.cpp \
     controller/animationstateaggregator.cpp \
@@ -102,6 +127,8 @@ SOURCES += \
     controller/pathfinder/pathsearchcriteria.cpp \
     controller/pathfinder/pathsearchaction.cpp \
     controller/pathfinder/pathfinder.cpp \
+    controller/pathfinder/pushplanner.cpp \
+    controller/pathfinder/routesearch.cpp \
     model/futureshotpath.cpp \
     view/pushview.cpp \
     model/push.cpp \
@@ -113,6 +140,7 @@ SOURCES += \
     view/replaytext.cpp \
     util/workerthread.cpp \
     controller/gameinitializer.cpp \
+    controller/evalserver.cpp \
     controller/gameregistry.cpp \
     model/level.cpp \
     view/levelchooser.cpp \
@@ -120,7 +148,10 @@ SOURCES += \
     view/tiledragmarker.cpp \
     view/levelcompleteddialog.cpp \
     util/qltxmlhandler.cpp \
-    view/whatsthisaware.cpp
+    view/whatsthisaware.cpp \
+    view/repaintscheduler.cpp \
+    view/staticboardlayer.cpp \
+    view/thumbnailcache.cpp
 
 test{
     INCLUDEPATH += test/controller
@@ -136,17 +167,45 @@ test{
     SOURCES += test/testmain.cpp \
         test/util/testasync.cpp \
         test/controller/testgame.cpp \
+        test/controller/testevalserver.cpp \
         test/model/testpiecelistmanager.cpp \
         test/model/testfutureshotpath.cpp \
         test/controller/testmovecontroller.cpp \
         test/util/testrecorder.cpp \
         test/util/piecelistmanagerobserver.cpp \
         test/util/testworker.cpp \
+        test/util/testperfstats.cpp \
         test/model/testboardpool.cpp \
+        test/model/testboardsnapshot.cpp \
+        test/model/testboardchanges.cpp \
+        test/model/testdeadsquares.cpp \
         test/model/testlevellist.cpp \
         test/controller/testdrag.cpp \
         test/util/testpersist.cpp \
-        test/model/testshot.cpp
+        test/model/testshot.cpp \
+        test/view/testrepaintscheduler.cpp \
+        test/view/testthumbnailcache.cpp \
+        test/view/teststaticboardlayer.cpp \
+        test/util/testmapgenerator.cpp \
+        test/controller/testpathfinder.cpp
+
+    trace {
+        SOURCES += test/util/testtrace.cpp
+    }
+
+} else:bench {
+    TARGET = qltbench
+
+    QT += testlib
+
+    HEADERS += bench/benchmain.h
+
+    SOURCES += bench/benchmain.cpp \
+        bench/benchboard.cpp \
+        bench/benchpathfinder.cpp \
+        bench/benchgame.cpp \
+        bench/benchpersist.cpp \
+        bench/benchrecorder.cpp
 
 } else {
     TARGET = qlt
@@ -0,0 +1,75 @@
+#include <QBuffer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include "../testmain.h"
+#include "evalserver.h"
+#include "model/board.h"
+
+static Board* loadBoard( const char* map, int level )
+{
+    Board* board = new Board();
+    QTextStream stream( map );
+    board->load( stream, level );
+    return board;
+}
+
+void TestMain::testEvalServer()
+{
+    EvalServer server( 2 );
+    server.addBoard( loadBoard( "T..F\n", 1 ) );
+    server.addBoard( loadBoard( "T...\n"
+                                "....\n"
+                                "...<\n", 2 ) );
+
+    QByteArray requests(
+      "{\"id\":\"solve\",\"level\":1,\"moves\":\"RRRRRR\"}\n"
+      "{\"id\":\"short\",\"level\":1,\"moves\":\"RR\"}\n"
+      "{\"id\":\"turn\",\"level\":1,\"moves\":\"r\"}\n"
+      "{\"id\":\"turns\",\"level\":1,\"moves\":\"R L R\"}\n"
+      "\n"
+      "{\"id\":\"killed\",\"level\":2,\"moves\":\"DDDD\"}\n"
+      "{\"id\":\"blocked\",\"level\":2,\"moves\":\"UUF\"}\n"
+      "{\"id\":\"bad\",\"level\":1,\"moves\":\"RX\"}\n"
+      "{\"id\":7,\"level\":3,\"moves\":\"R\"}\n"
+      "not json\n" );
+    QBuffer input( &requests );
+    input.open( QIODevice::ReadOnly );
+    QByteArray results;
+    QBuffer output( &results );
+    output.open( QIODevice::WriteOnly );
+    server.serve( input, output );
+
+    // results arrive in completion order so key them by id:
+    std::map<QString,QJsonObject> responses;
+    int errors = 0;
+    for( const QByteArray& line : results.split( '\n' ) ) {
+        if ( !line.isEmpty() ) {
+            QJsonObject response = QJsonDocument::fromJson( line ).object();
+            responses[response.value( "id" ).toVariant().toString()] = response;
+            errors += response.contains( "error" );
+        }
+    }
+    QCOMPARE( (int) responses.size(), 9 );
+    QCOMPARE( errors, 3 );
+
+    // stops at the flag:
+    QCOMPARE( responses["solve"].value( "solved" ).toBool(), true );
+    QCOMPARE( responses["solve"].value( "steps" ).toInt(), 4 );
+    QCOMPARE( responses["short"].value( "solved" ).toBool(), false );
+    QCOMPARE( responses["short"].value( "steps" ).toInt(), 2 );
+
+    // the same end state hashes the same:
+    QCOMPARE( responses["turn"].value( "hash" ).toString(), responses["turns"].value( "hash" ).toString() );
+    QVERIFY( responses["turn"].value( "hash" ).toString() != responses["short"].value( "hash" ).toString() );
+
+    // stops on entering the cannon's sights:
+    QCOMPARE( responses["killed"].value( "killed" ).toBool(), true );
+    QCOMPARE( responses["killed"].value( "steps" ).toInt(), 3 );
+    QCOMPARE( responses["blocked"].value( "killed" ).toBool(), false );
+    QCOMPARE( responses["blocked"].value( "steps" ).toInt(), 3 );
+
+    QCOMPARE( responses["bad"].value( "error" ).toString(), QString( "unknown move command" ) );
+    QCOMPARE( responses["7"].value( "error" ).toString(), QString( "unknown level" ) );
+    QCOMPARE( responses[""].value( "error" ).toString(), QString( "malformed request" ) );
+}
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <atomic>
+#include <QThread>
 #include "../testmain.h"
 #include "controller/game.h"
 #include "controller/animationstateaggregator.h"
@@ -20,9 +22,9 @@ void TestMain::testGameMove()
     Board* board = game.getBoard();
     cout << "board " << board->getWidth() << "x" << board->getHeight() << endl;
 
-    const PieceSet& tiles = board->getPieceManager().getPieces();
+    const PieceVector& tiles = board->getPieceManager().getPieces();
     QCOMPARE( (int) tiles.size(), 1 );
-    QCOMPARE( (*tiles.begin())->encodedPos(), Piece::encodePos(1,2));
+    QCOMPARE( tiles.begin()->encodedPos(), Piece::encodePos(1,2));
 
     // check off-board values;
     QCOMPARE( game.canPlaceAt(TANK,ModelPoint(-1, 0),270), false );
@@ -141,3 +143,50 @@ void TestMain::testIsMasterBoard()
     QVERIFY( game->isMasterBoard(game->getBoard(true )) == false );
     QVERIFY( game->isMasterBoard(game->getDeltaFutureBoard()) == false );
 }
+
+/**
+ * @brief Plays a headless game on its own thread using its own registry
+ */
+class HeadlessGameThread : public QThread
+{
+public:
+    HeadlessGameThread( const char* map, int blockedCol ) : mMap(map), mBlockedCol(blockedCol), mPassed(false)
+    {
+    }
+
+    void run() override
+    {
+        GameRegistry registry;
+        Game& game = registry.getGame();
+        game.init( &registry );
+        QTextStream stream( mMap );
+        game.getBoard()->load( stream );
+
+        // each game sees only its own board:
+        bool passed = true;
+        for( int col = 1; col < 4; ++col ) {
+            passed = passed && game.canPlaceAt( TANK, ModelPoint( col, 0 ), 90 ) == (col != mBlockedCol);
+        }
+
+        // and numbers its own shot paths:
+        MovePiece move( MOVE, 0, 0, 90, 1 );
+        const FutureShotPath* path = registry.getMoveController().getFutureShots().updateShots( 0, &move );
+        mPassed = passed && path && move.getShotPathUID() == 1;
+    }
+
+    const char* mMap;
+    int mBlockedCol;
+    std::atomic<bool> mPassed;
+};
+
+void TestMain::testParallelGames()
+{
+    HeadlessGameThread first(  "T.W.\n", 2 );
+    HeadlessGameThread second( "T..W\n", 3 );
+    first.start();
+    second.start();
+    QVERIFY( first.wait( 10000 ) );
+    QVERIFY( second.wait( 10000 ) );
+    QVERIFY( first.mPassed );
+    QVERIFY( second.mPassed );
+}
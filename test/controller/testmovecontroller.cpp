@@ -1,4 +1,5 @@
 #include <iostream>
+#include <QCoreApplication>
 #include <QObject>
 #include <QRect>
 #include "../testmain.h"
@@ -6,6 +7,7 @@
 #include "movecontroller.h"
 #include "game.h"
 #include "animationstateaggregator.h"
+#include "model/board.h"
 #include "model/tank.h"
 #include "model/shotmodel.h"
 #include "util/recorder.h"
@@ -180,6 +182,138 @@ void TestMain::testReplay()
     QVERIFY( boardPieces.typeAt(ModelPoint(1,2)) == TILE );
 }
 
+void TestMain::testTurboReplay()
+{
+    initGame( "T.........\n" );
+
+    MoveController& moveController = mRegistry.getMoveController();
+    GameClock& clock = mRegistry.getSpeedController().getClock();
+    Tank& tank = mRegistry.getTank();
+
+    // record a drive which takes most of a minute at normal speed:
+    clock.setTurbo( true );
+    QSignalSpy idleSpy( &moveController, &MoveController::idle );
+    for( int lap = 0; lap < 3; ++lap ) {
+        for( int i = 0; i < 10; ++i ) {
+            moveController.move( 90 );
+        }
+        for( int i = 0; i < 10; ++i ) {
+            moveController.move( 270 );
+        }
+    }
+    QVERIFY( idleSpy.wait( 5000 ) );
+    clock.setTurbo( false );
+    QCOMPARE( tank.getVector(), ModelVector( 0, 0, 270 ) );
+
+    mRegistry.getGame().turboReplayLevel();
+    QVERIFY( clock.getTurbo() );
+    QCOMPARE( tank.getVector(), ModelVector( 0, 0, 0 ) );
+
+    QSignalSpy replaySpy( &moveController, &MoveController::replayChanged );
+    QVERIFY( replaySpy.wait( 5000 ) );
+    QVERIFY( !clock.getTurbo() );
+    QCOMPARE( tank.getVector(), ModelVector( 0, 0, 270 ) );
+
+    // turbo skips the tank's animations rather than running them quickly; it is on the next square straight away:
+    clock.setTurbo( true );
+    ModelVector next( 1, 0, 270 );
+    QVERIFY( tank.doMove( next ) );
+    QCOMPARE( tank.getViewX().toInt(), 24 );
+    QVERIFY( mRegistry.getMoveAggregate().active() ); // until the clock delivers the finish
+    clock.setTurbo( false );
+}
+
+void TestMain::testSpeedMultiplier()
+{
+    initGame( "T.........\n" );
+
+    MoveController& moveController = mRegistry.getMoveController();
+    SpeedController& speedController = mRegistry.getSpeedController();
+    GameClock& clock = speedController.getClock();
+    Tank& tank = mRegistry.getTank();
+    QSignalSpy idleSpy( &moveController, &MoveController::idle );
+
+    // step through the clock time the multiplier makes of the given wall time:
+    clock.setManual( true );
+    auto stepWall = [&]( int msecs ) { clock.step( static_cast<int>( msecs * speedController.getSpeedMultiplier() ) ); };
+
+    speedController.setSpeedMultiplier( 100 );
+    QCOMPARE( speedController.getSpeedMultiplier(), GameClock::MaxRate );
+    QCOMPARE( clock.getRequestedTickRate(), 4000 );
+
+    // a drive which takes several seconds at normal speed:
+    for( int i = 0; i < 10; ++i ) {
+        moveController.move( 90 );
+    }
+    clock.step( 0 );
+    idleSpy.clear();
+    stepWall( 1000 );
+    QCOMPARE( idleSpy.count(), 1 );
+    QCOMPARE( tank.getVector(), ModelVector( 9, 0, 90 ) );
+
+    // slow motion; turning around takes over six seconds:
+    speedController.setSpeedMultiplier( 0 );
+    QCOMPARE( speedController.getSpeedMultiplier(), GameClock::MinRate );
+    moveController.move( 270 );
+    clock.step( 0 );
+    idleSpy.clear();
+    stepWall( 1000 );
+    QCOMPARE( idleSpy.count(), 0 );
+
+    // finishes at normal speed:
+    speedController.setSpeedMultiplier( 1 );
+    stepWall( 3000 );
+    QCOMPARE( idleSpy.count(), 1 );
+    QCOMPARE( tank.getVector(), ModelVector( 9, 0, 270 ) );
+
+    clock.setManual( false );
+}
+
+void TestMain::testClockStep()
+{
+    initGame( "T..\n" );
+
+    MoveController& moveController = mRegistry.getMoveController();
+    GameClock& clock = mRegistry.getSpeedController().getClock();
+    Tank& tank = mRegistry.getTank();
+    QSignalSpy idleSpy( &moveController, &MoveController::idle );
+
+    clock.setManual( true );
+    QVERIFY( clock.getManual() );
+    moveController.move( 90 );
+    clock.step( 0 );
+    idleSpy.clear();
+
+    // the quarter turn takes 800ms of clock time regardless of wall time:
+    clock.step( 400 );
+    QCOMPARE( idleSpy.count(), 0 );
+    QVERIFY( mRegistry.getMoveAggregate().active() );
+
+    clock.step( 416 );
+    QCOMPARE( idleSpy.count(), 1 );
+    QCOMPARE( tank.getVector(), ModelVector( 0, 0, 90 ) );
+
+    clock.setManual( false );
+}
+
+void TestMain::testClockInactive()
+{
+    // a clock which isn't driving the animations defers its aggregators' notifications to the event loop:
+    GameClock clock;
+    AnimationStateAggregator aggregator;
+    clock.addAggregator( &aggregator );
+    QSignalSpy finishedSpy( &aggregator, &AnimationStateAggregator::finished );
+
+    aggregator.onStateChanged( QAbstractAnimation::Running, QAbstractAnimation::Stopped );
+    aggregator.onStateChanged( QAbstractAnimation::Stopped, QAbstractAnimation::Running );
+    QCOMPARE( finishedSpy.count(), 0 );
+    QVERIFY( aggregator.active() );
+
+    QCoreApplication::sendPostedEvents( &clock );
+    QCOMPARE( finishedSpy.count(), 1 );
+    QVERIFY( !aggregator.active() );
+}
+
 void TestMain::testMoveFocus()
 {
     initGame(
@@ -198,3 +332,77 @@ void TestMain::testMoveFocus()
     moveController.setFocus( MOVE );
     QVERIFY( !tank.getVector().equals( moveController.getBaseFocusVector() ) );
 }
+
+class PausedMoveController : public MoveController
+{
+public:
+    bool canWakeup() override {
+        return false;
+    }
+};
+
+void TestMain::testMoveEdit()
+{
+    auto moveController = new PausedMoveController();
+    mRegistry.injectMoveController( moveController );
+    initGame(
+      "[T>..M.........................................\n" );
+
+    // a plan long enough to span more than one checkpoint, pushing the tile along ahead of the tank:
+    for( int i = 0; i < 40; ++i ) {
+        moveController->move( 90 );
+    }
+    PieceListManager& moves = moveController->getMoves();
+    QCOMPARE( moves.size(), 40 );
+    QCOMPARE( mRegistry.getGame().getBoard(true)->getPieceManager().typeAt( ModelPoint(41,0) ), TILE );
+
+    // shooting the tile further ahead late in the plan:
+    QCOMPARE( moveController->replaceMove( 35, MovePiece( MOVE, 36, 0, 90, 5 ) ), 0 );
+    QCOMPARE( moves.size(), 40 );
+    QCOMPARE( moves.getBack(4)->getShotCount(), 5 );
+    QVERIFY( moves.getBack()->ModelPoint::equals( ModelPoint(40,0) ) );
+    Board* futureBoard = mRegistry.getGame().getBoard(true);
+    QCOMPARE( futureBoard->getPieceManager().typeAt( ModelPoint(41,0) ), NONE );
+    QCOMPARE( futureBoard->getPieceManager().typeAt( ModelPoint(42,0) ), TILE );
+
+    // removing an early move replays the rest of the plan one step short:
+    QCOMPARE( moveController->eraseMove( 2 ), 0 );
+    QCOMPARE( moves.size(), 39 );
+    QVERIFY( moves.getBack()->ModelPoint::equals( ModelPoint(39,0) ) );
+    QCOMPARE( moves.getBack(4)->getShotCount(), 5 );
+    futureBoard = mRegistry.getGame().getBoard(true);
+    QCOMPARE( futureBoard->getPieceManager().typeAt( ModelPoint(42,0) ), NONE );
+    QCOMPARE( futureBoard->getPieceManager().typeAt( ModelPoint(41,0) ), TILE );
+
+    // the plan can be extended again as before:
+    moveController->move( 90 );
+    moveController->move( 90 );
+    QCOMPARE( moves.size(), 41 );
+    QCOMPARE( mRegistry.getGame().getBoard(true)->getPieceManager().typeAt( ModelPoint(42,0) ), TILE );
+
+    // edits beyond the plan are refused:
+    QCOMPARE( moveController->eraseMove( 41 ), -1 );
+}
+
+void TestMain::testMoveEditDrop()
+{
+    auto moveController = new PausedMoveController();
+    mRegistry.injectMoveController( moveController );
+    initGame(
+      "[T>...\n"
+      ".S..\n" );
+
+    // across, down then across:
+    for( int direction : { 90, 90, 180, 180, 90, 90 } ) {
+        moveController->move( direction );
+    }
+    PieceListManager& moves = moveController->getMoves();
+    QCOMPARE( moves.size(), 4 );
+    QVERIFY( moves.getBack()->ModelPoint::equals( ModelPoint(3,1) ) );
+
+    // without the second step across, the step down runs into the stone. Rather than carry on from the wrong square,
+    // it and the last step are dropped:
+    QCOMPARE( moveController->eraseMove( 1 ), 2 );
+    QCOMPARE( moves.size(), 1 );
+    QCOMPARE( ModelVector( *moves.getBack() ), ModelVector( 1, 0, 90 ) );
+}
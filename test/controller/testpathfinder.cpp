@@ -0,0 +1,200 @@
+#include <QTextStream>
+#include "../testmain.h"
+#include "gameregistry.h"
+#include "game.h"
+#include "pathfindercontroller.h"
+#include "pathsearchaction.h"
+#include "model/board.h"
+#include "model/tank.h"
+#include "util/mapgenerator.h"
+#include "../test/util/testasync.h"
+
+class PathReceiver : public QObject, public TestAsync
+{
+public:
+    PathReceiver( PathFinderController& controller ) : mSize(-1), mPushCount(0), mTurnCount(0), mReachable(-1)
+    {
+        QObject::connect( &controller, &PathFinderController::pathFound,  this, &PathReceiver::onPath );
+        QObject::connect( &controller, &PathFinderController::testResult, this, &PathReceiver::onResult );
+    }
+
+    bool condition() override
+    {
+        return mSize >= 0 || mReachable >= 0;
+    }
+
+    void onPath( PieceListManager* path, PathSearchCriteria* criteria )
+    {
+        mSize = path->size();
+        if ( Piece* back = path->getBack() ) {
+            mEndPoint = ModelPoint( back->getCol(), back->getRow() );
+        }
+        int angle = criteria->getStartVector().mAngle;
+        for( const auto& it : path->getList() ) {
+            if ( it.hasPush() ) {
+                ++mPushCount;
+            }
+            if ( it.getAngle() != angle ) {
+                angle = it.getAngle();
+                ++mTurnCount;
+            }
+        }
+    }
+
+    void onResult( bool reachable, PathSearchCriteria* /*criteria*/ )
+    {
+        mReachable = reachable;
+    }
+
+    int mSize;
+    int mPushCount;
+    int mTurnCount;
+    int mReachable;
+    ModelPoint mEndPoint;
+};
+
+void TestMain::testPathFinderLargeBoard()
+{
+    // An obstacle-free board of the maximum size. Searching out from its center grows a frontier of ~4 squares per
+    // step, far more than a couple of rows worth
+    MapGenerator generator( BoardMaxWidth, BoardMaxHeight );
+    for( auto setter : { &MapGenerator::setWallDensity, &MapGenerator::setWaterDensity, &MapGenerator::setMirrorDensity,
+                         &MapGenerator::setWoodDensity, &MapGenerator::setTileDensity, &MapGenerator::setCannonDensity } ) {
+        (generator.*setter)( 0 );
+    }
+    QString map = generator.generate( MapGenerator::OpenField );
+    QTextStream stream( &map );
+    initGame( stream );
+
+    ModelPoint center( BoardMaxWidth/2, BoardMaxHeight/2 );
+    PathSearchAction& action = mRegistry.getPathToAction();
+    QVERIFY( action.setCriteria( TANK, center ) );
+
+    PathReceiver receiver( mRegistry.getPathFinderController() );
+    QVERIFY( mRegistry.getPathFinderController().doAction( &action ) );
+    QVERIFY( receiver.test( 5000 ) );
+
+    // shortest path: one move per square of manhattan distance, plus the initial turn away from the top edge
+    QCOMPARE( receiver.mSize, center.mCol + center.mRow + 1 );
+    QVERIFY( receiver.mEndPoint == center );
+}
+
+void TestMain::testPathTurns()
+{
+    initGame(
+      "[T>...\n"
+      "....\n"
+      "....\n"
+      "....\n" );
+
+    ModelPoint target( 3, 3 );
+    PathSearchAction& action = mRegistry.getPathToAction();
+    QVERIFY( action.setCriteria( TANK, target ) );
+
+    PathReceiver receiver( mRegistry.getPathFinderController() );
+    QVERIFY( mRegistry.getPathFinderController().doAction( &action ) );
+    QVERIFY( receiver.test() );
+
+    // across then down; any other shortest route turns more
+    QCOMPARE( receiver.mSize, 6 );
+    QCOMPARE( receiver.mTurnCount, 1 );
+    QVERIFY( receiver.mEndPoint == target );
+}
+
+void TestMain::testPathCosts()
+{
+    // the staircase is shortest but turns at every step; the border is longer with only two turns
+    const char* map =
+      "[T>......\n"
+      "S.SSSS.\n"
+      "S..SSS.\n"
+      "SS..SS.\n"
+      "SSS....\n";
+    initGame( map );
+
+    ModelPoint target( 5, 4 );
+    PathSearchAction& action = mRegistry.getPathToAction();
+    PathFinderController& controller = mRegistry.getPathFinderController();
+    QVERIFY( action.setCriteria( TANK, target ) );
+
+    PathReceiver borderReceiver( controller );
+    QVERIFY( controller.doAction( &action ) );
+    QVERIFY( borderReceiver.test() );
+    QCOMPARE( borderReceiver.mSize, 11 );
+    QCOMPARE( borderReceiver.mTurnCount, 2 );
+    QVERIFY( borderReceiver.mEndPoint == target );
+
+    // free turns favor the fewest moves:
+    initGame( map );
+    controller.setPathCosts( 1, 0 );
+    QVERIFY( action.setCriteria( TANK, target ) );
+    PathReceiver stairReceiver( controller );
+    QVERIFY( controller.doAction( &action ) );
+    QVERIFY( stairReceiver.test() );
+    QCOMPARE( stairReceiver.mSize, 9 );
+    QVERIFY( stairReceiver.mEndPoint == target );
+}
+
+void TestMain::testTankPathCosts()
+{
+    // the tank moves a square in the time it turns a quarter:
+    Tank& tank = mRegistry.getTank();
+    int moveCost = tank.getMoveDuration( SpeedController::NormalSpeed );
+    QCOMPARE( moveCost, SpeedController::NormalSpeed );
+    QCOMPARE( tank.getRotateDuration( SpeedController::NormalSpeed ), moveCost );
+
+    // a quarter turn in a quarter of the move time favors the staircase of testPathCosts:
+    initGame(
+      "[T>......\n"
+      "S.SSSS.\n"
+      "S..SSS.\n"
+      "SS..SS.\n"
+      "SSS....\n" );
+
+    ModelPoint target( 5, 4 );
+    PathSearchAction& action = mRegistry.getPathToAction();
+    PathFinderController& controller = mRegistry.getPathFinderController();
+    controller.setPathCosts( moveCost, moveCost/4 );
+    QVERIFY( action.setCriteria( TANK, target ) );
+    PathReceiver receiver( controller );
+    QVERIFY( controller.doAction( &action ) );
+    QVERIFY( receiver.test() );
+    QCOMPARE( receiver.mSize, 9 );
+    QVERIFY( receiver.mEndPoint == target );
+}
+
+void TestMain::testPushPath()
+{
+    // the only way through is to sink the tile
+    initGame(
+      "TMw.\n"
+      "SSSS\n" );
+
+    ModelPoint target( 3, 0 );
+    PathSearchAction& action = mRegistry.getPathToAction();
+    PathFinderController& controller = mRegistry.getPathFinderController();
+
+    // unreachable without pushing:
+    QVERIFY( action.setCriteria( TANK, target, 0 ) );
+    PathReceiver directReceiver( controller );
+    QVERIFY( controller.doAction( &action, true ) );
+    QVERIFY( directReceiver.test() );
+    QCOMPARE( directReceiver.mReachable, 0 );
+
+    // tests don't route through pushes, even given a budget:
+    QVERIFY( action.setCriteria( TANK, target, PlayerPathPushBudget ) );
+    PathReceiver testReceiver( controller );
+    QVERIFY( controller.doAction( &action, true ) );
+    QVERIFY( testReceiver.test() );
+    QCOMPARE( testReceiver.mReachable, 0 );
+
+    QVERIFY( action.setCriteria( TANK, target, PlayerPathPushBudget ) );
+    PathReceiver pushReceiver( controller );
+    QVERIFY( controller.doAction( &action ) );
+    QVERIFY( pushReceiver.test() );
+    QCOMPARE( pushReceiver.mPushCount, 1 );
+    QVERIFY( pushReceiver.mEndPoint == target );
+
+    // the push was applied to the future board:
+    QCOMPARE( mRegistry.getGame().getBoard(true)->tileAt( ModelPoint(2,0) ), TILE_SUNK );
+}
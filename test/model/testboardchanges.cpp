@@ -0,0 +1,43 @@
+#include <QTextStream>
+#include "../testmain.h"
+#include "model/board.h"
+
+void TestMain::testBoardChanges()
+{
+    QString map(
+      "T.W.\n"
+      ".M..\n"
+      "..w.\n"
+    );
+    QTextStream stream( &map );
+    Board board;
+    QSignalSpy spy( &board, &Board::changesCommitted );
+    board.load( stream );
+    QVERIFY( spy.count() == 0 ); // loads only notify boardLoaded
+
+    // outside a transaction each change notifies:
+    board.setTileAt( WOOD_DAMAGED, ModelPoint( 2, 0 ) );
+    QVERIFY( spy.count() == 1 );
+    BoardChangeSet changes = qvariant_cast<BoardChangeSet>( spy.takeFirst().at(0) );
+    QVERIFY( changes.mTileChanges == 1 && changes.mPieceChanges == 0 && !changes.mDirtExposed );
+
+    // inside, changes coalesce into one notification on the outermost commit:
+    board.beginChanges();
+    board.setTileAt( DIRT, ModelPoint( 2, 0 ) );
+    board.beginChanges();
+    board.getPieceManager().eraseAt( ModelPoint( 1, 1 ) );
+    board.getPieceManager().insert( TILE, ModelPoint( 3, 2 ) );
+    board.commitChanges();
+    QVERIFY( spy.count() == 0 );
+    board.commitChanges();
+    QVERIFY( spy.count() == 1 );
+    changes = qvariant_cast<BoardChangeSet>( spy.takeFirst().at(0) );
+    QVERIFY( changes.mTileChanges == 1 && changes.mPieceChanges == 2 && changes.mDirtExposed );
+    QVERIFY( changes.mTopLeft.equals( ModelPoint( 1, 0 ) ) );
+    QVERIFY( changes.mBottomRight.equals( ModelPoint( 3, 2 ) ) );
+
+    // an empty transaction doesn't notify:
+    board.beginChanges();
+    board.commitChanges();
+    QVERIFY( spy.count() == 0 );
+}
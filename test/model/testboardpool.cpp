@@ -2,7 +2,9 @@
 #include <set>
 #include "../testmain.h"
 #include "model/boardpool.h"
+#include "model/level.h"
 #include "controller/gameregistry.h"
+#include "util/workerthread.h"
 
 using namespace std;
 
@@ -25,6 +27,28 @@ public:
         QVERIFY( loadSpy.wait( 1000 ) );
     }
 
+    /**
+     * @brief wait for the given total number of boardLoaded signals, verifying the concurrent loads stay within the cap
+     */
+    void waitLoaded( QSignalSpy& loadSpy, int count, unsigned maxLoading )
+    {
+        while( loadSpy.count() < count ) {
+            QVERIFY( loadSpy.wait( 1000 ) );
+            QVERIFY( mLoading.size() <= maxLoading );
+        }
+        QCOMPARE( loadSpy.count(), count );
+    }
+
+    bool isLoading( int level )
+    {
+        return mLoading.find( level ) != mLoading.end();
+    }
+
+    unsigned loadingCount()
+    {
+        return mLoading.size();
+    }
+
     void printContents()
     {
         bool separate = false;
@@ -92,3 +116,63 @@ void TestMain::testBoardPool()
 
     testPool->verifyContents( { 10, 11, 12 } );
 }
+
+void TestMain::testBoardPoolLoadCap()
+{
+    mRegistry.injectWorkerPool( new WorkerPool( 2 ) );
+    auto testPool = new TestPool( 6, 0 );
+    mRegistry.injectBoardPool( testPool );
+    QSignalSpy loadSpy( testPool, &BoardPool::boardLoaded );
+
+    // request the whole visible window at once:
+    for( int level = 1; level <= 6; ++level ) {
+        QVERIFY( !testPool->getBoard( level ) );
+        QVERIFY( testPool->loadingCount() <= 2 );
+    }
+    QCOMPARE( testPool->loadingCount(), 2U );
+
+    // the rest are started as loads complete, never more than the pool's threads at once:
+    testPool->waitLoaded( loadSpy, 6, 2 );
+    testPool->verifyContents( { 1, 2, 3, 4, 5, 6 } );
+}
+
+void TestMain::testBoardPoolPrefetch()
+{
+    mRegistry.injectWorkerPool( new WorkerPool( 2 ) );
+    LevelList levelList;
+    for( int number = 1; number <= 12; ++number ) {
+        levelList.addLevel( number, 10, 10 );
+    }
+
+    // 4 visible with capacity for 2 more:
+    auto testPool = new TestPool( 4, 0 );
+    mRegistry.injectBoardPool( testPool );
+    testPool->init( levelList, 0 );
+    QSignalSpy loadSpy( testPool, &BoardPool::boardLoaded );
+
+    QVERIFY( !testPool->getBoard( 1 ) );
+    testPool->waitLoaded( loadSpy, 4, 2 );
+    testPool->verifyContents( { 1, 2, 3, 4 } );
+
+    // a single step doesn't establish a direction:
+    QVERIFY( !testPool->getBoard( 5 ) );
+    testPool->waitLoaded( loadSpy, 5, 2 );
+    QVERIFY( !testPool->loadingCount() );
+    testPool->verifyContents( { 1, 2, 3, 4, 5 } );
+
+    // repeating it prefetches ahead of the window:
+    QVERIFY( !testPool->getBoard( 6 ) );
+    QVERIFY( testPool->isLoading( 7 ) );
+
+    // boards still loading are not handed out:
+    QVERIFY( !testPool->getBoard( 6 ) );
+    QVERIFY( !testPool->find( 6 ) );
+    QVERIFY( !testPool->find( 7 ) );
+
+    testPool->waitLoaded( loadSpy, 7, 2 );
+    QVERIFY( !testPool->loadingCount() );
+
+    // level 7 recycled the furthest board (level 1). Level 8 isn't prefetched since the only boards left to recycle are
+    // nearer to the window than it is:
+    testPool->verifyContents( { 2, 3, 4, 5, 6, 7 } );
+}
@@ -0,0 +1,58 @@
+#include <QTextStream>
+#include "../testmain.h"
+#include "model/board.h"
+
+void TestMain::testBoardSnapshot()
+{
+    QString map(
+      "T.W\n"
+      ".M.\n"
+      "..[M/\n"
+    );
+    QTextStream stream( &map );
+    Board board;
+    board.load( stream );
+
+    std::shared_ptr<const BoardSnapshot> first = board.getSnapshot();
+    QVERIFY( first->getVersion() == board.getVersion() );
+    QVERIFY( first->getLowerRight().equals( ModelPoint( 2, 2 ) ) );
+    QVERIFY( first->tileAt( ModelPoint( 2, 0 ) ) == WOOD );
+    QVERIFY( first->tileAt( ModelPoint( 3, 0 ) ) == EMPTY );
+    QVERIFY( first->pieceCount() == 2 );
+    QVERIFY( first->pieceAt( ModelPoint( 1, 1 ) ) == TILE );
+    int angle = -1;
+    QVERIFY( first->pieceAt( ModelPoint( 2, 2 ), &angle ) == TILE_MIRROR && angle == 0 );
+    QVERIFY( first->pieceAt( ModelPoint( 0, 0 ) ) == NONE );
+
+    // unchanged boards publish the same snapshot:
+    QVERIFY( board.getSnapshot() == first );
+
+    // a tile change only copies its row; the published snapshot stays as it was
+    board.setTileAt( DIRT, ModelPoint( 2, 0 ) );
+    std::shared_ptr<const BoardSnapshot> second = board.getSnapshot();
+    QVERIFY( second->getVersion() > first->getVersion() );
+    QVERIFY( first->tileAt( ModelPoint( 2, 0 ) ) == WOOD );
+    QVERIFY( second->tileAt( ModelPoint( 2, 0 ) ) == DIRT );
+    QVERIFY( !second->sharesRow( 0, *first ) );
+    QVERIFY( second->sharesRow( 1, *first ) && second->sharesRow( 2, *first ) );
+    QVERIFY( second->sharesPieces( *first ) );
+
+    // a piece change shares all the rows
+    board.getPieceManager().eraseAt( ModelPoint( 1, 1 ) );
+    std::shared_ptr<const BoardSnapshot> third = board.getSnapshot();
+    QVERIFY( third->getVersion() > second->getVersion() );
+    QVERIFY( !third->sharesPieces( *second ) );
+    QVERIFY( third->pieceAt( ModelPoint( 1, 1 ) ) == NONE );
+    QVERIFY( second->pieceAt( ModelPoint( 1, 1 ) ) == TILE );
+    for( int row = 0; row < 3; ++row ) {
+        QVERIFY( third->sharesRow( row, *second ) );
+    }
+
+    // snapshot rules match the live board's:
+    QVERIFY( Game::canPlaceAt( TANK, ModelPoint( 1, 1 ), *third ) );
+    QVERIFY( !Game::canPlaceAt( TANK, ModelPoint( 1, 1 ), *second ) );
+    angle = 0;
+    QVERIFY( Game::canShootThru( *third, ModelPoint( 2, 2 ), &angle ) && angle == 90 );
+    angle = 90;
+    QVERIFY( !Game::canShootThru( *second, ModelPoint( 1, 1 ), &angle ) );
+}
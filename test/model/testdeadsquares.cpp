@@ -0,0 +1,74 @@
+#include <vector>
+#include <QTextStream>
+#include "../testmain.h"
+#include "model/board.h"
+
+void TestMain::testDeadSquares()
+{
+    // without water only the corners trap a tile:
+    QString dryMap(
+      "T...\n"
+      "....\n"
+    );
+    QTextStream dryStream( &dryMap );
+    Board board;
+    board.load( dryStream );
+    QVERIFY(  board.isDeadSquare( ModelPoint( 0, 0 ) ) );
+    QVERIFY( !board.isDeadSquare( ModelPoint( 1, 0 ) ) );
+    QVERIFY(  board.isDeadSquare( ModelPoint( 3, 1 ) ) );
+    QVERIFY( !board.isDeadSquare( ModelPoint( 2, 1 ) ) );
+
+    // with water, a tile along the bottom edge can no longer be pushed up to it:
+    QString wetMap(
+      "....w\n"
+      ".....\n"
+      ".....\n"
+    );
+    QTextStream wetStream( &wetMap );
+    board.load( wetStream );
+    for( int col = 0; col < 5; ++col ) {
+        QVERIFY( board.isDeadSquare( ModelPoint( col, 2 ) ) );
+    }
+    QVERIFY(  board.isDeadSquare( ModelPoint( 0, 0 ) ) );
+    QVERIFY(  board.isDeadSquare( ModelPoint( 0, 1 ) ) );
+    QVERIFY( !board.isDeadSquare( ModelPoint( 1, 1 ) ) );
+    QVERIFY( !board.isDeadSquare( ModelPoint( 3, 0 ) ) );
+    QVERIFY( !board.isDeadSquare( ModelPoint( 4, 0 ) ) ); // the water itself
+    QVERIFY( !board.isDeadSquare( ModelPoint( 5, 0 ) ) ); // off the board
+
+    // copies carry the analysis:
+    Board copy;
+    copy.load( &board );
+    QVERIFY(  copy.isDeadSquare( ModelPoint( 2, 2 ) ) );
+    QVERIFY( !copy.isDeadSquare( ModelPoint( 2, 1 ) ) );
+}
+
+void TestMain::testTileStranded()
+{
+    initGame(
+      "....w\n"
+      "TM...\n"
+      ".....\n" );
+
+    // force the move aggregate active so the tank won't be woken up:
+    mRegistry.getMoveAggregate().onStateChanged( QAbstractAnimation::Running, QAbstractAnimation::Stopped );
+
+    QObject receiver;
+    std::vector<ModelPoint> stranded;
+    QObject::connect( &mRegistry.getGame(), &Game::tileStranded, &receiver, [&stranded]( const ModelPoint& point, bool futuristic ) {
+        if ( futuristic ) {
+            stranded.push_back( point );
+        }
+    } );
+    MoveController& moveController = mRegistry.getMoveController();
+    moveController.move(   0 );
+    moveController.move(  90 );
+    moveController.move(  90 );
+    QVERIFY( stranded.empty() );
+
+    // pushing the tile down on to the bottom edge strands it:
+    moveController.move( 180 );
+    moveController.move( 180 );
+    QCOMPARE( (int) stranded.size(), 1 );
+    QVERIFY( stranded.front().equals( ModelPoint( 1, 2 ) ) );
+}
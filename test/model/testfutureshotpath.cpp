@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include "../testmain.h"
 #include "model/futureshotpath.h"
@@ -92,11 +93,12 @@ void TestMain::testFutureMultiShotThruTank()
     moveController.move(180);
     moveController.fire(2);
     QCOMPARE( TILE, mRegistry.getGame().getBoard(true)->getPieceManager().pieceAt(ModelPoint(1,3))->getType() );
-    SimplePiece key(MOVE, 1, 3 );
-    auto it = mRegistry.getGame().getDeltaPieces()->find( &key );
-    QVERIFY( it != mRegistry.getGame().getDeltaPieces()->end() );
-    cout << "type=" << (*it)->getType() << endl;
-    QVERIFY( (*it)->getType() == TILE_FUTURE_INSERT );
+    const PieceVector* deltas = mRegistry.getGame().getDeltaPieces();
+    auto it = std::find_if( deltas->begin(), deltas->end(),
+                            []( const PushedPiece& piece ) { return piece.encodedPos() == Piece::encodePos( 1, 3 ); } );
+    QVERIFY( it != deltas->end() );
+    cout << "type=" << it->getType() << endl;
+    QVERIFY( it->getType() == TILE_FUTURE_INSERT );
 }
 
 class MyTestGame : public Game
@@ -116,22 +118,22 @@ void TestMain::testFutureShotPushId()
       "[T>.M....\n" );
     MoveController& moveController = mRegistry.getMoveController();
     game->enableFuture();
-    const PieceSet& boardPieces = mRegistry.getGame().getBoard(true)->getPieceManager().getPieces();
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 0 );
+    const PieceVector& boardPieces = mRegistry.getGame().getBoard(true)->getPieceManager().getPieces();
+    QCOMPARE( boardPieces.begin()->getPushedId(), 0 );
 
     moveController.fire(2);
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 2 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 2 );
 
     moveController.move(90);
     moveController.fire(2);
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 4 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 4 );
 
     moveController.undoLastMove();
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 2 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 2 );
 
     moveController.move(90);
     moveController.fire(2);
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 4 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 4 );
 }
 
 class SleepingMoveController : public MoveController
@@ -155,8 +157,8 @@ void TestMain::testFutureShotPartialUndo()
     moveController->fire(2);
     moveController->fire(1);
 
-    const PieceSet& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
-    QVERIFY( ModelPoint(1,0).equals( *(*boardPieces.begin()) ) );
+    const PieceVector& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
+    QVERIFY( ModelPoint(1,0).equals( *boardPieces.begin() ) );
 }
 
 void TestMain::testFutureShotPushIdWater()
@@ -168,12 +170,12 @@ void TestMain::testFutureShotPushIdWater()
     initGame(
       "[T>M..w\n" );
     game->enableFuture();
-    const PieceSet& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 0 );
+    const PieceVector& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
+    QCOMPARE( boardPieces.begin()->getPushedId(), 0 );
 
     moveController->fire(3);
     moveController->fire(2);
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 2 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 2 );
 }
 
 void TestMain::testFutureShot2PushIdWater()
@@ -207,11 +209,50 @@ void TestMain::testFutureShotTankKill()
       " .  <    .\n"
       "[T^[S\\[/S\n" );
     game->enableFuture();
-    const PieceSet& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
+    const PieceVector& boardPieces = game->getBoard(true)->getPieceManager().getPieces();
 
     moveController->fire(2);
     QVERIFY( boardPieces.empty() );
 
     moveController->fire(1);
-    QCOMPARE( (*boardPieces.begin())->getPushedId(), 1 );
+    QCOMPARE( boardPieces.begin()->getPushedId(), 1 );
+}
+
+void TestMain::testFutureShotPathIndex()
+{
+    initGame(
+      "[T>...................W\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n"
+      ".....................\n" );
+
+    FutureShotPathManager manager;
+    manager.setParent( &mRegistry );
+
+    MovePiece move( MOVE, 0, 0, 90, 1 );
+    const FutureShotPath* path = manager.updateShots( 0, &move );
+    QVERIFY( path != nullptr );
+
+    std::vector<const FutureShotPath*> paths;
+    manager.getPathsIn( QRect( 12*24, 0, 24, 24 ), paths );
+    QCOMPARE( (int) paths.size(), 1 );
+    QCOMPARE( paths[0], path );
+
+    // areas well away from the path don't visit it:
+    manager.getPathsIn( QRect( 12*24, 10*24, 24, 24 ), paths );
+    QVERIFY( paths.empty() );
+    manager.getPathsIn( QRect( 30*24, 0, 24, 24 ), paths );
+    QVERIFY( paths.empty() );
+
+    move.setShotCount( 0 );
+    manager.updateShots( 1, &move );
+    manager.getPathsIn( QRect( 12*24, 0, 24, 24 ), paths );
+    QVERIFY( paths.empty() );
 }
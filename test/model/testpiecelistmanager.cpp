@@ -24,4 +24,34 @@ void TestMain::testPieceListManager()
     manager.eraseBack();
     QCOMPARE( (int) manager.toSet()->size(), 0 );
     QCOMPARE( (int) manager.toMultiSet()->size(), 0 );
+
+    // indexed access from the back:
+    for( int col = 0; col < 5; ++col ) {
+        manager.append( MOVE, ModelPoint(col, 0) );
+    }
+    manager.push_front( MOVE, ModelVector(0, 1, 0) );
+    QVERIFY( manager.getBack(0)->ModelPoint::equals( ModelPoint(4, 0) ) );
+    QVERIFY( manager.getBack(4)->ModelPoint::equals( ModelPoint(0, 0) ) );
+    QVERIFY( manager.getBack(5)->ModelPoint::equals( ModelPoint(0, 1) ) );
+    QVERIFY( !manager.getBack(6) );
+    QVERIFY( (*manager.toMultiSet()->begin())->ModelPoint::equals( ModelPoint(0, 0) ) );
+
+    // transferring empties the source and keeps the index in step:
+    PieceListManager target;
+    target.reset( &manager, false );
+    QCOMPARE( manager.size(), 0 );
+    QCOMPARE( (int) manager.toMultiSet()->size(), 0 );
+    QCOMPARE( target.size(), 6 );
+    QCOMPARE( (int) target.toMultiSet()->size(), 6 );
+    QVERIFY( target.getFront()->ModelPoint::equals( ModelPoint(0, 1) ) );
+
+    // appending a copy of a board piece keeps its pushed id:
+    PushedPiece pushed( TILE, ModelPoint(2, 3), 0, 7 );
+    Piece* copy = target.append( &pushed );
+    QCOMPARE( copy->getType(), TILE );
+    QCOMPARE( copy->getPushedId(), 7 );
+    QCOMPARE( target.getBack()->getPushedId(), 7 );
+    PieceListManager copied;
+    copied.reset( &target );
+    QCOMPARE( copied.getBack()->getPushedId(), 7 );
 }
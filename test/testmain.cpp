@@ -1,5 +1,6 @@
 #include <iostream>
 #include <set>
+#include <QGuiApplication>
 #include <QSignalSpy>
 #include <QString>
 
@@ -16,25 +17,25 @@ TestRegistry::~TestRegistry()
 void TestRegistry::cleanup()
 {
     mWorker.purge();
+    if ( mWorkerPool ) {
+        // a fresh pool for each test since tests may inject their own
+        delete mWorkerPool;
+        mWorkerPool = nullptr;
+    }
 
-#define DECL_CLEAN(name) { if ( m##name != nullptr ) { delete m##name; m##name=nullptr; } }
-    DECL_CLEAN(Game)
-    DECL_CLEAN(SpeedController)
-    DECL_CLEAN(MoveController)
-    DECL_CLEAN(PathFinderController)
-    DECL_CLEAN(MoveAggregate)
-    DECL_CLEAN(ShotAggregate)
-    DECL_CLEAN(BoardPool)
-    DECL_CLEAN(Tank)
-    DECL_CLEAN(ActiveCannon)
-    DECL_CLEAN(TankPush)
-    DECL_CLEAN(ShotPush)
-    DECL_CLEAN(LevelList)
-    DECL_CLEAN(Recorder)
-    DECL_CLEAN(Persist)
+    deleteComponents();
 }
 
-QTEST_GUILESS_MAIN(TestMain)
+int main( int argc, char** argv )
+{
+    // thumbnails are rendered from pixmaps which require a gui application. Render offscreen so no display is needed
+    if ( !qEnvironmentVariableIsSet( "QT_QPA_PLATFORM" ) ) {
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+    }
+    QGuiApplication app( argc, argv );
+    TestMain testMain;
+    return QTest::qExec( &testMain, argc, argv );
+}
 
 TestMain::TestMain() : mStream(0)
 {
@@ -20,6 +20,7 @@ class TestPathFinderController;
 #include "model/level.h"
 #include "util/recorder.h"
 #include "util/persist.h"
+#include "view/thumbnailcache.h"
 
 class TestRegistry : public GameRegistry
 {
@@ -53,6 +54,12 @@ DECL_INJECT(ShotPush,Push)
 DECL_INJECT(LevelList,LevelList)
 DECL_INJECT(Recorder,Recorder)
 DECL_INJECT(Persist,Persist)
+DECL_INJECT(ThumbnailCache,ThumbnailCache)
+
+    void injectWorkerPool( WorkerPool* pWorkerPool ) {
+      QVERIFY(mWorkerPool == nullptr);
+      mWorkerPool = pWorkerPool;
+    }
 };
 
 class TestMain : public QObject
@@ -82,6 +89,12 @@ private slots:
     void testDragPoint();
     void testDragWithMove();
 
+    void testPathFinderLargeBoard();
+    void testPathTurns();
+    void testPathCosts();
+    void testTankPathCosts();
+    void testPushPath();
+
     void testPersistSizes();
     void testPersistNew();
     void testPersistReplace();
@@ -91,10 +104,18 @@ private slots:
     void testLevelCompleted();
 
     void testBoardPool();
+    void testBoardPoolLoadCap();
+    void testBoardPoolPrefetch();
+    void testBoardSnapshot();
+    void testBoardChanges();
+    void testDeadSquares();
+    void testTileStranded();
 
     void testGameMove();
     void testGameCannon();
     void testGamePush();
+    void testParallelGames();
+    void testEvalServer();
 
     void testPieceListManager();
 
@@ -107,6 +128,7 @@ private slots:
     void testFutureShotPushIdWater();
     void testFutureShot2PushIdWater();
     void testFutureShotTankKill();
+    void testFutureShotPathIndex();
 
     void testRecorderBitFields();
     void testRecorderRecordSize();
@@ -120,9 +142,28 @@ private slots:
     void testMultiShotShooterRelease();
     void testMultiShotShotFinished();
     void testReplay();
+    void testTurboReplay();
+    void testSpeedMultiplier();
+    void testClockStep();
+    void testClockInactive();
     void testMoveFocus();
+    void testMoveEdit();
+    void testMoveEditDrop();
 
     void testWorker();
+    void testWorkerPool();
+    void testPerfStats();
+#ifdef QLT_TRACE
+    void testTrace();
+#endif // QLT_TRACE
+
+    void testThumbnailCache();
+    void testStaticBoardLayer();
+
+    void testRepaintCoalesce();
+    void testRepaintCap();
+
+    void testMapGenerator();
 
     void cleanup();
 
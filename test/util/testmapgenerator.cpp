@@ -0,0 +1,30 @@
+#include <QTextStream>
+#include "../testmain.h"
+#include "util/mapgenerator.h"
+#include "model/board.h"
+
+void TestMain::testMapGenerator()
+{
+    for( auto layout : { MapGenerator::OpenField, MapGenerator::Maze, MapGenerator::MirrorField } ) {
+        MapGenerator generator( BoardMaxWidth, BoardMaxHeight, 7 );
+        QString map = generator.generate( layout );
+
+        // the same seed reproduces the same map; a different seed doesn't:
+        QCOMPARE( generator.generate( layout ), map );
+        QVERIFY( MapGenerator( BoardMaxWidth, BoardMaxHeight, 8 ).generate( layout ) != map );
+
+        Board board;
+        QTextStream stream( &map );
+        board.load( stream );
+        QCOMPARE( board.getWidth(), BoardMaxWidth );
+        QCOMPARE( board.getHeight(), BoardMaxHeight );
+        QVERIFY( board.getTankStartVector() == ModelPoint( 0, 0 ) );
+        QVERIFY( !board.getFlagPoint().isNull() );
+        QCOMPARE( board.tileAt( board.getFlagPoint() ), FLAG );
+    }
+
+    // sizes are clamped to the board limits:
+    MapGenerator oversize( BoardMaxWidth+10, 1 );
+    QCOMPARE( oversize.getWidth(), BoardMaxWidth );
+    QCOMPARE( oversize.getHeight(), 2 );
+}
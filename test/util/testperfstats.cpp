@@ -0,0 +1,57 @@
+#include <QJsonObject>
+#include "../testmain.h"
+#include "controller/gameregistry.h"
+#include "util/perfstats.h"
+
+class StatsRunnable : public BasicRunnable
+{
+public:
+    StatsRunnable() : mDone(false)
+    {
+    }
+
+    void run() override
+    {
+        QThread::msleep(2);
+        mDone = true;
+    }
+
+    bool mDone;
+};
+
+void TestMain::testPerfStats()
+{
+    PerfStats stats;
+    stats.record( PerfStats::PaintTime, 300 );
+    stats.record( PerfStats::PaintTime, 100 );
+    stats.record( PerfStats::PaintTime, 200 );
+
+    PerfStats::Counter counter = stats.get( PerfStats::PaintTime );
+    QCOMPARE( counter.count, 3LL );
+    QCOMPARE( counter.total, 600LL );
+    QCOMPARE( counter.min, 100LL );
+    QCOMPARE( counter.max, 300LL );
+    QCOMPARE( counter.last, 200LL );
+    QCOMPARE( stats.get( PerfStats::PersistTime ).count, 0LL );
+
+    QJsonObject snapshot = stats.toJson();
+    QJsonObject paint = snapshot.value( PerfStats::getName( PerfStats::PaintTime ) ).toObject();
+    QCOMPARE( paint.value( "count" ).toInt(), 3 );
+    QCOMPARE( paint.value( "mean" ).toDouble(), 200.0 );
+    for( int metric = 0; metric < PerfStats::MetricCount; ++metric ) {
+        QVERIFY( snapshot.contains( PerfStats::getName( static_cast<PerfStats::Metric>(metric) ) ) );
+    }
+
+    stats.reset();
+    QCOMPARE( stats.get( PerfStats::PaintTime ).count, 0LL );
+
+    // the registry's worker reports its queue depth and latency:
+    PerfStats& registryStats = mRegistry.getPerfStats();
+    registryStats.reset();
+    StatsRunnable runnable;
+    mRegistry.getWorker().doWork( &runnable );
+    QTRY_VERIFY_WITH_TIMEOUT( registryStats.get( PerfStats::RunnableLatency ).count == 1, 1000 );
+    QVERIFY( runnable.mDone );
+    QCOMPARE( registryStats.get( PerfStats::WorkerQueueDepth ).last, 1LL );
+    QVERIFY( registryStats.get( PerfStats::RunnableLatency ).last >= 2000 );
+}
@@ -0,0 +1,117 @@
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <atomic>
+#include <thread>
+#include "../testmain.h"
+#include "util/trace.h"
+#include "util/workerthread.h"
+
+static int countZones( const QJsonArray& events, const QString& name, int* tid )
+{
+    int count = 0;
+    for( const auto& value : events ) {
+        QJsonObject event = value.toObject();
+        if ( event.value( "ph" ).toString() == "X" && event.value( "name" ).toString() == name ) {
+            *tid = event.value( "tid" ).toInt();
+            ++count;
+        }
+    }
+    return count;
+}
+
+static QString threadName( const QJsonArray& events, int tid )
+{
+    QString name;
+    for( const auto& value : events ) {
+        QJsonObject event = value.toObject();
+        if ( event.value( "ph" ).toString() == "M" && event.value( "tid" ).toInt() == tid ) {
+            name = event.value( "args" ).toObject().value( "name" ).toString();
+        }
+    }
+    return name;
+}
+
+static QJsonArray saveTrace()
+{
+    const char* path = "qlttest-trace.json";
+    QJsonArray events;
+    if ( Trace::save( path ) ) {
+        QFile file( path );
+        if ( file.open( QIODevice::ReadOnly ) ) {
+            events = QJsonDocument::fromJson( file.readAll() ).object().value( "traceEvents" ).toArray();
+            file.close();
+        }
+        file.remove();
+    }
+    return events;
+}
+
+class NamedRunnable : public BasicRunnable
+{
+public:
+    NamedRunnable() : mDone(false)
+    {
+    }
+
+    const char* getName() const override
+    {
+        return "testTraceRunnable";
+    }
+
+    void run() override
+    {
+        mDone = true;
+    }
+
+    std::atomic<bool> mDone;
+};
+
+void TestMain::testTrace()
+{
+    {   TraceScope scope( "testTraceApp" );
+    }
+    std::thread other( [] {
+        Trace::setThreadName( "testTraceThread" );
+        // overflow the ring so only the newest zones are kept:
+        for( unsigned i = 0; i < Trace::BufferCapacity + 10; ++i ) {
+            Trace::record( "testTraceOther", Trace::now(), 1 );
+        }
+    } );
+    other.join();
+
+    QJsonArray events = saveTrace();
+    QVERIFY( !events.isEmpty() );
+
+    // one slot is held back for the zone being written:
+    int appTid = 0, otherTid = 0;
+    QCOMPARE( countZones( events, "testTraceApp", &appTid ), 1 );
+    QCOMPARE( countZones( events, "testTraceOther", &otherTid ), static_cast<int>(Trace::BufferCapacity) - 1 );
+    QVERIFY( appTid != otherTid );
+    QCOMPARE( threadName( events, otherTid ), QString("testTraceThread") );
+
+    // the next thread reuses the released buffer without its previous zones or name:
+    std::thread reuse( [] {
+        Trace::record( "testTraceReuse", Trace::now(), 1 );
+    } );
+    reuse.join();
+
+    events = saveTrace();
+    int reuseTid = 0, staleTid = 0;
+    QCOMPARE( countZones( events, "testTraceReuse", &reuseTid ), 1 );
+    QCOMPARE( reuseTid, otherTid );
+    QCOMPARE( countZones( events, "testTraceOther", &staleTid ), 0 );
+    QCOMPARE( threadName( events, reuseTid ), QString("thread") );
+
+    // worker zones are named by their runnable:
+    NamedRunnable runnable;
+    mRegistry.getWorker().doWork( &runnable );
+    QTRY_VERIFY( runnable.mDone );
+    mRegistry.getWorker().purge(); // joins, so the zone is complete
+
+    events = saveTrace();
+    int workerTid = 0;
+    QCOMPARE( countZones( events, "testTraceRunnable", &workerTid ), 1 );
+    QCOMPARE( threadName( events, workerTid ), QString("worker") );
+}
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <condition_variable>
+#include <map>
 #include "../testmain.h"
 #include "controller/gameregistry.h"
 #include "../util/testasync.h"
@@ -52,3 +54,90 @@ void TestMain::testWorker()
     QVERIFY( testWorker.test() );
     mRegistry.getWorker().shutdown();
 }
+
+class PoolGate
+{
+public:
+    PoolGate() : mOpen(false), mDone(0)
+    {
+    }
+
+    void open()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mOpen = true;
+        mCondition.notify_all();
+    }
+
+    void pass()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait( lock, [this] { return mOpen; } );
+        ++mRuns[std::this_thread::get_id()];
+        ++mDone;
+        mCondition.notify_all();
+    }
+
+    bool waitDone( int count )
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        return mCondition.wait_for( lock, std::chrono::seconds(5), [this,count] { return mDone >= count; } );
+    }
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mOpen;
+    int mDone;
+    std::map<std::thread::id,int> mRuns;
+};
+
+class GatedRunnable : public BasicRunnable
+{
+public:
+    GatedRunnable( PoolGate& gate ) : mGate(gate)
+    {
+    }
+
+    void run() override
+    {
+        mGate.pass();
+    }
+
+    bool deleteWhenDone() override
+    {
+        return true;
+    }
+
+private:
+    PoolGate& mGate;
+};
+
+/**
+ * @brief test that tasks queued from several threads are spread evenly across the pool
+ */
+void TestMain::testWorkerPool()
+{
+    const int perProducer = 4 * 3;
+    PoolGate gate;
+    {   WorkerPool pool( 3 );
+        QCOMPARE( pool.size(), 3U );
+
+        // The gate holds each thread's first task so its queue stays non-empty and all of its tasks run on one thread
+        auto produce = [&pool,&gate] {
+            for( int i = 0; i < perProducer; ++i ) {
+                pool.doWork( new GatedRunnable( gate ) );
+            }
+        };
+        std::thread producer( produce );
+        produce();
+        producer.join();
+
+        gate.open();
+        QVERIFY( gate.waitDone( 2 * perProducer ) );
+    }
+
+    QCOMPARE( static_cast<int>( gate.mRuns.size() ), 3 );
+    for( auto it : gate.mRuns ) {
+        QCOMPARE( it.second, 2 * perProducer / 3 );
+    }
+}
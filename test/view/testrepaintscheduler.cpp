@@ -0,0 +1,47 @@
+#include <QRegion>
+#include "../testmain.h"
+#include "view/repaintscheduler.h"
+
+void TestMain::testRepaintCoalesce()
+{
+    RepaintScheduler scheduler;
+    QSignalSpy updateSpy( &scheduler, &RepaintScheduler::updateRequested );
+
+    // overlapping and adjacent rects merge:
+    scheduler.schedule( QRect(  0, 0, 24, 24 ) );
+    scheduler.schedule( QRect( 12, 0, 24, 24 ) );
+    scheduler.schedule( QRect( 36, 0, 24, 24 ) );
+    QCOMPARE( (int) scheduler.getPending().size(), 1 );
+    QCOMPARE( scheduler.getPending().front(), QRect( 0, 0, 60, 24 ) );
+
+    // a distant rect stays disjoint:
+    scheduler.schedule( QRect( 240, 240, 24, 24 ) );
+    QCOMPARE( (int) scheduler.getPending().size(), 2 );
+
+    // the frame timer flushes once:
+    QVERIFY( updateSpy.wait( 1000 ) );
+    QCOMPARE( updateSpy.count(), 2 );
+    QVERIFY( scheduler.getPending().empty() );
+
+    scheduler.recordPainted( QRegion( 0, 0, 60, 24 ) + QRegion( 240, 240, 24, 24 ) );
+    QCOMPARE( scheduler.getLastFrameStats().rectCount, 2 );
+    QCOMPARE( scheduler.getLastFrameStats().pixelCount, 60*24 + 24*24 );
+}
+
+void TestMain::testRepaintCap()
+{
+    RepaintScheduler scheduler;
+    scheduler.setMaxRects( 2 );
+
+    scheduler.schedule( QRect(   0,   0, 24, 24 ) );
+    scheduler.schedule( QRect( 100,   0, 24, 24 ) );
+    QCOMPARE( (int) scheduler.getPending().size(), 2 );
+
+    scheduler.schedule( QRect(   0, 100, 24, 24 ) );
+    QCOMPARE( (int) scheduler.getPending().size(), 1 );
+    QCOMPARE( scheduler.getPending().front(), QRect( 0, 0, 124, 124 ) );
+
+    QSignalSpy updateSpy( &scheduler, &RepaintScheduler::updateRequested );
+    scheduler.flush();
+    QCOMPARE( updateSpy.count(), 1 );
+}
@@ -0,0 +1,53 @@
+#include <QImage>
+#include <QPainter>
+#include "../testmain.h"
+#include "view/staticboardlayer.h"
+
+static QRect squareRect( int col, int row )
+{
+    return QRect( col*24, row*24, 24, 24 );
+}
+
+void TestMain::testStaticBoardLayer()
+{
+    QTextStream stream( "[T>MS..\n"
+                        "....F\n" );
+    Board board;
+    board.load( stream );
+
+    StaticBoardLayer layer( 24 );
+    layer.reset( board.getWidth()*24, board.getHeight()*24 );
+    QCOMPARE( layer.getStaleRegion(), QRegion( 0, 0, board.getWidth()*24, board.getHeight()*24 ) );
+    layer.refresh( &board );
+    QVERIFY( layer.getStaleRegion().isEmpty() );
+    QImage before = layer.getPixmap().toImage();
+
+    // change two squares but only invalidate the first:
+    board.setTileAt( WATER, ModelPoint( 3, 0 ) );
+    board.setTileAt( WATER, ModelPoint( 4, 0 ) );
+    layer.invalidate( squareRect( 3, 0 ) );
+    layer.refresh( &board );
+    QVERIFY( layer.getStaleRegion().isEmpty() );
+    QImage after = layer.getPixmap().toImage();
+
+    // the stale square is repainted:
+    QVERIFY( after.copy( squareRect( 3, 0 ) ) != before.copy( squareRect( 3, 0 ) ) );
+
+    // the untouched squares come from the cache, including the one changed without being invalidated:
+    for( int row = 0; row < board.getHeight(); ++row ) {
+        for( int col = 0; col < board.getWidth(); ++col ) {
+            if ( col != 3 || row != 0 ) {
+                QCOMPARE( after.copy( squareRect( col, row ) ), before.copy( squareRect( col, row ) ) );
+            }
+        }
+    }
+
+    // painting copies from the layer:
+    QImage painted( after.size(), after.format() );
+    painted.fill( Qt::white );
+    {   QPainter painter( &painted );
+        layer.paint( QRegion( squareRect( 3, 0 ) ), &painter );
+    }
+    QCOMPARE( painted.copy( squareRect( 3, 0 ) ), after.copy( squareRect( 3, 0 ) ) );
+    QCOMPARE( painted.pixel( squareRect( 0, 1 ).center() ), QColor( Qt::white ).rgb() );
+}
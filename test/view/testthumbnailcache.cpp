@@ -0,0 +1,67 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include "../testmain.h"
+#include "view/levelchooser.h"
+#include "util/imageutils.h"
+
+static QByteArray readMap( int level )
+{
+    QFile file( QString( ":/maps/level%1.txt" ).arg( level ) );
+    if ( !file.open( QIODevice::ReadOnly ) ) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+static bool saveMarker( const QString& path )
+{
+    QImage marker( 1, 1, QImage::Format_ARGB32_Premultiplied );
+    marker.fill( Qt::red );
+    return marker.save( path );
+}
+
+void TestMain::testThumbnailCache()
+{
+    QTemporaryDir dir;
+    QVERIFY( dir.isValid() );
+    QDir cacheDir( dir.path() );
+    TileImageSet images( ChooserTileSize );
+    QCOMPARE( images.version(), TileImageSet( ChooserTileSize ).version() );
+
+    auto cache = new ThumbnailCache( 2, qPrintable(dir.path()) );
+    mRegistry.injectThumbnailCache( cache );
+    QSignalSpy readySpy( cache, &ThumbnailCache::thumbnailReady );
+
+    // a miss renders in the background and saves to disk:
+    QVERIFY( !cache->getThumbnail( 1 ) );
+    QVERIFY( readySpy.wait( 5000 ) );
+    QCOMPARE( readySpy.takeFirst().at(0).toInt(), 1 );
+    const QImage* image = cache->find( 1 );
+    QVERIFY( image && image->width() > 1 );
+    QVERIFY( cacheDir.exists( ThumbnailCache::cacheFileName( readMap( 1 ), images ) ) );
+
+    // then hits in memory:
+    QCOMPARE( cache->getThumbnail( 1 ), image );
+    QCOMPARE( readySpy.count(), 0 );
+
+    // a file under the current key is loaded rather than rendered:
+    QVERIFY( saveMarker( cacheDir.absoluteFilePath( ThumbnailCache::cacheFileName( readMap( 2 ), images ) ) ) );
+    QVERIFY( !cache->getThumbnail( 2 ) );
+    QVERIFY( readySpy.wait( 5000 ) );
+    QCOMPARE( cache->find( 2 )->size(), QSize( 1, 1 ) );
+
+    // touch 1 so 2 is the least recently used:
+    QVERIFY( cache->getThumbnail( 1 ) );
+
+    // a stale file, saved before the map changed, is ignored:
+    QVERIFY( saveMarker( cacheDir.absoluteFilePath( ThumbnailCache::cacheFileName( readMap( 3 ) + "\n", images ) ) ) );
+    QVERIFY( !cache->getThumbnail( 3 ) );
+    QVERIFY( readySpy.wait( 5000 ) );
+    QVERIFY( cache->find( 3 )->width() > 1 );
+
+    // at capacity, the least recently used was evicted:
+    QVERIFY( cache->find( 1 ) );
+    QVERIFY( !cache->find( 2 ) );
+    QVERIFY( cache->find( 3 ) );
+}
@@ -126,6 +126,11 @@ public:
     {
     }
 
+    const char* getName() const override
+    {
+        return "HelpLoadRunnable";
+    }
+
     void run() override
     {
         QFile source( ":/help/qlthelp.html" );
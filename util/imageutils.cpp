@@ -1,7 +1,9 @@
 #include <iostream>
 #include <string>
+#include <QCryptographicHash>
 #include <QPixmap>
 #include <QPainter>
+#include <QTransform>
 
 #include "imageutils.h"
 #include "model/board.h"
@@ -142,3 +144,67 @@ const QPixmap* ResourcePixmap::getForColor( const QColor& color ) const
     }
     return this;
 }
+
+const QPixmap* ResourcePixmap::getRotated( int angle, int size, const QColor* color ) const
+{
+    if ( angle % 90 || size <= 0 || isNull() ) {
+        return nullptr;
+    }
+
+    const QPixmap* source = color ? getForColor( *color ) : this;
+    int quadrant = ((angle / 90) % 4 + 4) % 4;
+    int key = (size << 3) | (quadrant << 1) | (source != this ? 1 : 0);
+
+    auto it = mAtlas.find( key );
+    if ( it == mAtlas.end() ) {
+        QPixmap pixmap;
+        if ( source->width() == size && source->height() == size ) {
+            pixmap = *source;
+        } else {
+            pixmap = source->scaled( size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+        }
+        if ( quadrant ) {
+            QTransform transform;
+            transform.rotate( quadrant * 90 );
+            pixmap = pixmap.transformed( transform );
+        }
+        it = mAtlas.emplace( key, pixmap ).first;
+    }
+    return &it->second;
+}
+
+TileImageSet::TileImageSet( int tileSize ) : mTileSize(tileSize)
+{
+    QCryptographicHash hash( QCryptographicHash::Sha1 );
+    for( unsigned type = 0; type < PixmapTypeUpperBound; ++type ) {
+        const ResourcePixmap* pixmap = ResourcePixmap::getPixmap( type );
+        for( int quadrant = 0; quadrant < 4; ++quadrant ) {
+            if ( const QPixmap* rotated = pixmap->getRotated( quadrant * 90, tileSize ) ) {
+                auto it = mImages.emplace( (type << 2) | quadrant, rotated->toImage() ).first;
+                const QImage& image = it->second;
+                hash.addData( QByteArray::number( it->first ) );
+                hash.addData( reinterpret_cast<const char*>( image.constBits() ), static_cast<int>( image.sizeInBytes() ) );
+            }
+        }
+    }
+    mVersion = hash.result().toHex();
+}
+
+int TileImageSet::tileSize() const
+{
+    return mTileSize;
+}
+
+const QByteArray& TileImageSet::version() const
+{
+    return mVersion;
+}
+
+const QImage* TileImageSet::get( unsigned type, int angle ) const
+{
+    auto it = mImages.find( (type << 2) | ((angle / 90) % 4 + 4) % 4 );
+    if ( it != mImages.end() ) {
+        return &it->second;
+    }
+    return nullptr;
+}
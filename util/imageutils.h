@@ -3,6 +3,7 @@
 
 #include <map>
 #include <QPixmap>
+#include <QImage>
 
 #include "view/pieceview.h"
 
@@ -51,16 +52,58 @@ public:
      */
     const QPixmap* getForColor( const QColor& color ) const;
 
+    /**
+     * @brief Get this pixmap pre-rendered at the given size and right-angle rotation.
+     * Variants are built on first use and cached thereafter so that painting them is a plain blit.
+     * @param angle The rotation. Must be a multiple of 90.
+     * @param size The width and height of the resulting square pixmap
+     * @param color If non-null, selects the color variant as per getForColor
+     * @return The cached pixmap, or nullptr if the angle is not a right angle or this pixmap is null
+     */
+    const QPixmap* getRotated( int angle, int size, const QColor* color = nullptr ) const;
+
 private:
     static ResourcePixmap* getNullPixmap();
 
     const char* mName;
     int mTagCount;
     QPixmap* mBluePixmap;
+    mutable std::map<int,QPixmap> mAtlas;
 
     static std::map<int,ResourcePixmap> nameMap;
     static ResourcePixmap* nameArray[PixmapTypeUpperBound];
     static ResourcePixmap* NullPixmap;
 };
 
+/**
+ * @brief A read-only snapshot of every resource image pre-rendered at a single tile size and each right angle.
+ * Unlike pixmaps, these images may be painted from any thread once constructed. Construct it on the application thread.
+ */
+class TileImageSet
+{
+public:
+    explicit TileImageSet( int tileSize );
+
+    int tileSize() const;
+
+    /**
+     * @brief Get a tag identifying the artwork these images were rendered from
+     * @return A hash of the image content which changes whenever any resource image changes
+     */
+    const QByteArray& version() const;
+
+    /**
+     * @brief Get the image for the given type and rotation
+     * @param type Identifier. Can be a PieceType, TileType or PixmapType value.
+     * @param angle The rotation. Must be a multiple of 90.
+     * @return The image or nullptr if none
+     */
+    const QImage* get( unsigned type, int angle ) const;
+
+private:
+    int mTileSize;
+    std::map<int,QImage> mImages;
+    QByteArray mVersion;
+};
+
 #endif // IMAGEUTILS_H
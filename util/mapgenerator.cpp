@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <list>
+
+#include "mapgenerator.h"
+#include "model/board.h"
+
+static const char* const Dirt  = ".";
+static const char* const Stone = "S";
+
+// minimum mirror density for the MirrorField layout
+static const int MirrorFieldDensity = 300;
+
+MapGenerator::MapGenerator( int width, int height, unsigned seed ) : mWidth(std::min( std::max( width, 2 ), BoardMaxWidth )),
+  mHeight(std::min( std::max( height, 2 ), BoardMaxHeight )), mSeed(seed), mWallDensity{150}, mWaterDensity{20},
+  mMirrorDensity{10}, mWoodDensity{20}, mTileDensity{20}, mCannonDensity{5}
+{
+}
+
+void MapGenerator::setWallDensity( int perMille )   { mWallDensity   = perMille; }
+void MapGenerator::setWaterDensity( int perMille )  { mWaterDensity  = perMille; }
+void MapGenerator::setMirrorDensity( int perMille ) { mMirrorDensity = perMille; }
+void MapGenerator::setWoodDensity( int perMille )   { mWoodDensity   = perMille; }
+void MapGenerator::setTileDensity( int perMille )   { mTileDensity   = perMille; }
+void MapGenerator::setCannonDensity( int perMille ) { mCannonDensity = perMille; }
+
+int MapGenerator::getWidth() const
+{
+    return mWidth;
+}
+
+int MapGenerator::getHeight() const
+{
+    return mHeight;
+}
+
+unsigned MapGenerator::next( unsigned range )
+{
+    // not using std distributions as their output is implementation specific
+    return static_cast<unsigned>( mRandom() % range );
+}
+
+bool MapGenerator::chance( int perMille )
+{
+    return perMille > 0 && static_cast<int>( next( 1000 ) ) < perMille;
+}
+
+QString MapGenerator::generate( Layout layout )
+{
+    mRandom.seed( mSeed );
+    mCells.assign( mWidth * mHeight, Dirt );
+
+    switch( layout ) {
+    case Maze:
+        carveMaze();
+        break;
+    case MirrorField:
+        scatter( mWallDensity, std::max( mMirrorDensity, MirrorFieldDensity ) );
+        break;
+    default:
+        scatter( mWallDensity, mMirrorDensity );
+        break;
+    }
+    placeFlag();
+    mCells[0] = "T";
+
+    QString text;
+    text.reserve( mWidth * mHeight * 2 );
+    for( int row = 0; row < mHeight; ++row ) {
+        for( int col = 0; col < mWidth; ++col ) {
+            text += mCells[row*mWidth + col];
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+void MapGenerator::carveMaze()
+{
+    // Corridor squares are at even coordinates; odd squares are the walls between them
+    std::fill( mCells.begin(), mCells.end(), Stone );
+
+    static const int offsets[4][2] = { { 0, -2 }, { 2, 0 }, { 0, 2 }, { -2, 0 } };
+
+    // iterative depth-first carve (a 256x256 maze would be too deep to recurse)
+    std::vector<int> stack;
+    stack.push_back( 0 );
+    mCells[0] = Dirt;
+    while( !stack.empty() ) {
+        int col = stack.back() % mWidth;
+        int row = stack.back() / mWidth;
+
+        int candidates[4];
+        int count = 0;
+        for( int i = 0; i < 4; ++i ) {
+            int c = col + offsets[i][0];
+            int r = row + offsets[i][1];
+            if ( c >= 0 && c < mWidth && r >= 0 && r < mHeight && mCells[r*mWidth + c] == Stone ) {
+                candidates[count++] = i;
+            }
+        }
+
+        if ( !count ) {
+            stack.pop_back();
+        } else {
+            int i = candidates[next( count )];
+            int c = col + offsets[i][0];
+            int r = row + offsets[i][1];
+            mCells[(row + offsets[i][1]/2)*mWidth + col + offsets[i][0]/2] = Dirt;
+            mCells[r*mWidth + c] = Dirt;
+            stack.push_back( r*mWidth + c );
+        }
+    }
+}
+
+void MapGenerator::scatter( int wallDensity, int mirrorDensity )
+{
+    static const char* const mirrors[] = { "[S/", "[\\S", "[/S", "[S\\", "[S-", "[S|", "[M/", "[\\M", "[/M", "[M\\" };
+    static const char* const cannons[] = { "^", ">", "v", "<" };
+
+    for( int row = 0; row < mHeight; ++row ) {
+        for( int col = 0; col < mWidth; ++col ) {
+            const char*& cell = mCells[row*mWidth + col];
+            // keep the tank's immediate neighborhood clear and its row and column free of cannons:
+            if ( cell != Dirt || (row < 2 && col < 2) ) {
+                continue;
+            }
+
+            if ( chance( wallDensity ) ) {
+                cell = Stone;
+            } else if ( chance( mWaterDensity ) ) {
+                cell = "w";
+            } else if ( chance( mirrorDensity ) ) {
+                cell = mirrors[next( (sizeof mirrors)/(sizeof *mirrors) )];
+            } else if ( chance( mWoodDensity ) ) {
+                cell = "W";
+            } else if ( chance( mTileDensity ) ) {
+                cell = "M";
+            } else if ( row && col && chance( mCannonDensity ) ) {
+                cell = cannons[next( (sizeof cannons)/(sizeof *cannons) )];
+            }
+        }
+    }
+}
+
+void MapGenerator::placeFlag()
+{
+    // breadth-first walk over dirt from the tank; the last square reached is the furthest
+    std::vector<bool> visited( mCells.size(), false );
+    std::list<int> queue;
+    queue.push_back( 0 );
+    visited[0] = true;
+    int last = 0;
+    while( !queue.empty() ) {
+        last = queue.front();
+        queue.pop_front();
+        int col = last % mWidth;
+        int row = last / mWidth;
+
+        int neighbors[4] = { row > 0 ? last - mWidth : -1, col < mWidth-1 ? last + 1 : -1,
+                             row < mHeight-1 ? last + mWidth : -1, col > 0 ? last - 1 : -1 };
+        for( int neighbor : neighbors ) {
+            if ( neighbor >= 0 && !visited[neighbor] && mCells[neighbor] == Dirt ) {
+                visited[neighbor] = true;
+                queue.push_back( neighbor );
+            }
+        }
+    }
+    if ( last ) {
+        mCells[last] = "F";
+    } else {
+        mCells[mCells.size()-1] = "F";
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef MAPGENERATOR_H
+#define MAPGENERATOR_H
+
+#include <vector>
+#include <random>
+#include <QString>
+
+/**
+ * @brief Generates synthetic level text for scaling tests and benchmarks.
+ * The same seed and settings always produce the same map. The tank starts in the top left corner and the flag is
+ * placed in the square furthest away (along the corridors for mazes).
+ */
+class MapGenerator
+{
+public:
+    typedef enum {
+        OpenField,   // Scattered obstacles over dirt
+        Maze,        // Single-width stone corridors; the densities don't apply
+        MirrorField  // Dense stone and tile mirrors
+    } Layout;
+
+    /**
+     * @brief Constructor
+     * @param width Number of columns. Clamped to 2..BoardMaxWidth
+     * @param height Number of rows. Clamped to 2..BoardMaxHeight
+     * @param seed Random seed
+     */
+    MapGenerator( int width, int height, unsigned seed = 1 );
+
+    /**
+     * @brief Feature densities, in tenths of a percent of the available dirt squares
+     */
+    void setWallDensity( int perMille );
+    void setWaterDensity( int perMille );
+    void setMirrorDensity( int perMille );
+    void setWoodDensity( int perMille );
+    void setTileDensity( int perMille );
+    void setCannonDensity( int perMille );
+
+    /**
+     * @brief Produce the level text for the given layout
+     */
+    QString generate( Layout layout );
+
+    int getWidth() const;
+    int getHeight() const;
+
+private:
+    unsigned next( unsigned range );
+    bool chance( int perMille );
+    void carveMaze();
+    void scatter( int wallDensity, int mirrorDensity );
+    void placeFlag();
+
+    int mWidth;
+    int mHeight;
+    unsigned mSeed;
+    int mWallDensity;
+    int mWaterDensity;
+    int mMirrorDensity;
+    int mWoodDensity;
+    int mTileDensity;
+    int mCannonDensity;
+
+    std::mt19937 mRandom;
+    std::vector<const char*> mCells;
+};
+
+#endif // MAPGENERATOR_H
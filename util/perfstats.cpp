@@ -0,0 +1,85 @@
+#include <iostream>
+#include <QFile>
+#include <QJsonDocument>
+
+#include "perfstats.h"
+
+static const char* const MetricNames[PerfStats::MetricCount] = {
+    "paintTimeUs",
+    "paintAreaPixels",
+    "workerQueueDepth",
+    "runnableLatencyUs",
+    "pathSearchTimeUs",
+    "pathSearchExpanded",
+    "shotTraceSteps",
+    "persistTimeUs"
+};
+
+PerfStats::PerfStats()
+{
+    reset();
+}
+
+void PerfStats::record( Metric metric, qint64 value )
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    Counter& counter = mCounters[metric];
+    if ( !counter.count++ ) {
+        counter.min = counter.max = value;
+    } else if ( value < counter.min ) {
+        counter.min = value;
+    } else if ( value > counter.max ) {
+        counter.max = value;
+    }
+    counter.total += value;
+    counter.last = value;
+}
+
+PerfStats::Counter PerfStats::get( Metric metric ) const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mCounters[metric];
+}
+
+const char* PerfStats::getName( Metric metric )
+{
+    return MetricNames[metric];
+}
+
+void PerfStats::reset()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    for( auto& counter : mCounters ) {
+        counter = { 0, 0, 0, 0, 0 };
+    }
+    mSince.start();
+}
+
+QJsonObject PerfStats::toJson() const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    QJsonObject snapshot;
+    snapshot.insert( "periodMs", static_cast<double>( mSince.elapsed() ) );
+    for( int metric = 0; metric < MetricCount; ++metric ) {
+        const Counter& counter = mCounters[metric];
+        QJsonObject object;
+        object.insert( "count", static_cast<double>( counter.count ) );
+        object.insert( "total", static_cast<double>( counter.total ) );
+        object.insert( "min",   static_cast<double>( counter.min ) );
+        object.insert( "max",   static_cast<double>( counter.max ) );
+        object.insert( "last",  static_cast<double>( counter.last ) );
+        object.insert( "mean",  counter.count ? static_cast<double>( counter.total ) / counter.count : 0.0 );
+        snapshot.insert( MetricNames[metric], object );
+    }
+    return snapshot;
+}
+
+bool PerfStats::save( const QString& path ) const
+{
+    QFile file( path );
+    if ( !file.open( QIODevice::WriteOnly|QIODevice::Truncate ) ) {
+        std::cout << "** PerfStats: can't write " << qPrintable(path) << ": " << qPrintable(file.errorString()) << std::endl;
+        return false;
+    }
+    return file.write( QJsonDocument( toJson() ).toJson() ) >= 0;
+}
@@ -0,0 +1,78 @@
+#ifndef PERFSTATS_H
+#define PERFSTATS_H
+
+#include <mutex>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+
+/**
+ * @brief Thread-safe performance counters for the game's hot spots.
+ * Each metric accumulates a count, total, minimum, maximum and most recent sample. Samples may be recorded from any
+ * thread. The counters can be exported as a JSON snapshot for diagnosing reported slowdowns.
+ */
+class PerfStats
+{
+public:
+    typedef enum {
+        PaintTime,          // microseconds spent in a board paint
+        PaintArea,          // pixels repainted by a board paint
+        WorkerQueueDepth,   // runnables pending when a runnable is queued
+        RunnableLatency,    // microseconds from queueing a runnable to its completion
+        PathSearchTime,     // microseconds spent in a path search
+        PathSearchExpanded, // cells expanded by a path search
+        ShotTraceSteps,     // squares traced by a shot path computation
+        PersistTime,        // microseconds spent in a persistent storage operation
+        MetricCount // must be last
+    } Metric;
+
+    typedef struct {
+        qint64 count;
+        qint64 total;
+        qint64 min;
+        qint64 max;
+        qint64 last;
+    } Counter;
+
+    PerfStats();
+
+    /**
+     * @brief Add a sample to a metric
+     */
+    void record( Metric metric, qint64 value );
+
+    /**
+     * @brief Get a consistent copy of a metric's counter
+     */
+    Counter get( Metric metric ) const;
+
+    /**
+     * @brief Get the name a metric is exported under
+     */
+    static const char* getName( Metric metric );
+
+    /**
+     * @brief Clear all counters
+     */
+    void reset();
+
+    /**
+     * @brief Take a snapshot of all counters
+     * @return An object keyed by metric name, plus the milliseconds covered by the snapshot
+     */
+    QJsonObject toJson() const;
+
+    /**
+     * @brief Write a snapshot of all counters to a file
+     * @param path The file to write
+     * @return true if successful
+     */
+    bool save( const QString& path ) const;
+
+private:
+    mutable std::mutex mMutex;
+    Counter mCounters[MetricCount];
+    QElapsedTimer mSince;
+};
+
+#endif // PERFSTATS_H
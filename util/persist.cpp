@@ -3,9 +3,12 @@
 #include <QFile>
 #include <QFile>
 #include <QDir>
+#include <QElapsedTimer>
 
 #include "persist.h"
 #include "workerthread.h"
+#include "perfstats.h"
+#include "trace.h"
 #include "recorder.h"
 #include "controller/gameregistry.h"
 #include "controller/movecontroller.h"
@@ -71,8 +74,14 @@ public:
 
     void runInternal() override
     {
+        TRACE_SCOPE( "PersistentRunnable" );
+        QElapsedTimer timer;
+        timer.start();
         ErrorableRunnable::runInternal();
         mFile.close(); // ensure closed without delay
+        if ( PerfStats* stats = mPersist.mStats ) {
+            stats->record( PerfStats::PersistTime, timer.nsecsElapsed() / 1000 );
+        }
     }
 
     void warn( const QString& msg )
@@ -160,6 +169,11 @@ public:
     {
     }
 
+    const char* getName() const override
+    {
+        return "InitRunnable";
+    }
+
     void run() override
     {
         if ( mFile.exists() ) {
@@ -214,6 +228,11 @@ public:
         delete mSource;
     }
 
+    const char* getName() const override
+    {
+        return "UpdateRunnable";
+    }
+
     void run() override
     {
         RunnableIndex newIndex;
@@ -365,13 +384,15 @@ private:
 };
 
 Persist::Persist( const char* path, QObject* parent ) : QObject(parent),
-  mPath(path ? path : QDir::home().absoluteFilePath("qlt.sav")), mFileUnusable{false}, mUpdateRunnable{nullptr}
+  mPath(path ? path : QDir::home().absoluteFilePath("qlt.sav")), mFileUnusable{false}, mUpdateRunnable{nullptr}, mStats{nullptr}
 {
     memset( &mFooter, 0, sizeof mFooter );
 }
 
 void Persist::init( GameRegistry* registry )
 {
+    mStats = &registry->getPerfStats();
+
     // background to foreground signal connection:
     QObject::connect( this, &Persist::indexReadyQueued, this, &Persist::onIndexReadyQueued,
       Qt::ConnectionType( Qt::QueuedConnection|Qt::UniqueConnection ) /* unique allows for multiple calls within tests*/ );
@@ -529,6 +550,11 @@ public:
         return mWorking;
     }
 
+    const char* getName() const override
+    {
+        return "LoadLevelRunnable";
+    }
+
     void run() override
     {
         eOpen( QIODevice::ReadOnly );
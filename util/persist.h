@@ -11,6 +11,7 @@ class Persist;
 class PersistentUpdateRunnable;
 class GameRegistry;
 class LoadLevelRunnable;
+class PerfStats;
 
 #include "loadable.h"
 #include "persistfile.h"
@@ -160,6 +161,7 @@ private:
     QTime mLastUpdateTime;
     PersistentUpdateRunnable* mUpdateRunnable;
     std::shared_ptr<Runnable> mSharedRunnable;
+    PerfStats* mStats;
 
     friend class PersistentRunnable;
     friend class PersistentUpdateRunnable;
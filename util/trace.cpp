@@ -0,0 +1,198 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "trace.h"
+
+constexpr unsigned Trace::BufferCapacity;
+
+typedef struct {
+    const char* name;
+    qint64 start;
+    qint64 duration;
+} TraceEvent;
+
+/**
+ * @brief A single producer ring of zones. Only the owning thread writes; readers copy a snapshot and discard any
+ * entries the writer may have overwritten during the copy.
+ */
+class TraceBuffer
+{
+public:
+    TraceBuffer( int tid ) : mTid(tid), mName(nullptr), mEvents(Trace::BufferCapacity), mHead(0)
+    {
+    }
+
+    void push( const char* name, qint64 start, qint64 duration )
+    {
+        unsigned long head = mHead.load( std::memory_order_relaxed );
+        mEvents[head % Trace::BufferCapacity] = { name, start, duration };
+        mHead.store( head + 1, std::memory_order_release );
+    }
+
+    void snapshot( std::vector<TraceEvent>& events ) const
+    {
+        unsigned long head = mHead.load( std::memory_order_acquire );
+        // the oldest slot is excluded; it's the one the writer overwrites next
+        unsigned long first = head >= Trace::BufferCapacity ? head - Trace::BufferCapacity + 1 : 0;
+        std::vector<TraceEvent> copy;
+        for( unsigned long index = first; index < head; ++index ) {
+            copy.push_back( mEvents[index % Trace::BufferCapacity] );
+        }
+
+        // drop whatever the writer lapped while copying, including the slot it may be part way through writing:
+        unsigned long lapped = mHead.load( std::memory_order_acquire );
+        unsigned long valid = lapped >= Trace::BufferCapacity ? lapped - Trace::BufferCapacity + 1 : 0;
+        for( unsigned long index = first; index < head; ++index ) {
+            if ( index >= valid ) {
+                events.push_back( copy[index - first] );
+            }
+        }
+    }
+
+    /**
+     * @brief Discard the previous owner's zones and name. Must not be called while a thread owns the buffer.
+     */
+    void reset()
+    {
+        mName.store( nullptr );
+        mHead.store( 0, std::memory_order_release );
+    }
+
+    const int mTid;
+    std::atomic<const char*> mName;
+
+private:
+    std::vector<TraceEvent> mEvents;
+    std::atomic<unsigned long> mHead;
+};
+
+/**
+ * @brief The process's trace buffers. Buffers outlive their threads so that short lived worker threads still appear
+ * in the timeline; a new thread reuses a released buffer rather than growing the set.
+ */
+class TraceRegistry
+{
+public:
+    TraceBuffer* acquire()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        if ( !mReleased.empty() ) {
+            // the released buffer stays in the timeline until it's reused:
+            TraceBuffer* buffer = mReleased.back();
+            mReleased.pop_back();
+            buffer->reset();
+            return buffer;
+        }
+        mBuffers.emplace_back( new TraceBuffer( static_cast<int>( mBuffers.size() ) + 1 ) );
+        return mBuffers.back().get();
+    }
+
+    void release( TraceBuffer* buffer )
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mReleased.push_back( buffer );
+    }
+
+    QJsonArray toJson()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        QJsonArray traceEvents;
+        std::vector<TraceEvent> events;
+        for( const auto& buffer : mBuffers ) {
+            QJsonObject metadata;
+            metadata.insert( "name", "thread_name" );
+            metadata.insert( "ph", "M" );
+            metadata.insert( "pid", 1 );
+            metadata.insert( "tid", buffer->mTid );
+            const char* name = buffer->mName.load();
+            metadata.insert( "args", QJsonObject{ { "name", name ? name : "thread" } } );
+            traceEvents.append( metadata );
+
+            events.clear();
+            buffer->snapshot( events );
+            for( const auto& event : events ) {
+                QJsonObject object;
+                object.insert( "name", event.name );
+                object.insert( "ph", "X" );
+                object.insert( "pid", 1 );
+                object.insert( "tid", buffer->mTid );
+                object.insert( "ts", static_cast<double>( event.start ) );
+                object.insert( "dur", static_cast<double>( event.duration ) );
+                traceEvents.append( object );
+            }
+        }
+        return traceEvents;
+    }
+
+private:
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> mBuffers;
+    std::vector<TraceBuffer*> mReleased;
+};
+
+static TraceRegistry& traceRegistry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Binds a buffer to the calling thread for the thread's lifetime
+ */
+class TraceThread
+{
+public:
+    TraceThread() : mBuffer(traceRegistry().acquire())
+    {
+    }
+
+    ~TraceThread()
+    {
+        traceRegistry().release( mBuffer );
+    }
+
+    TraceBuffer* const mBuffer;
+};
+
+static TraceBuffer* threadBuffer()
+{
+    static thread_local TraceThread thread;
+    return thread.mBuffer;
+}
+
+qint64 Trace::now()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - epoch ).count();
+}
+
+void Trace::record( const char* name, qint64 start, qint64 duration )
+{
+    threadBuffer()->push( name, start, duration );
+}
+
+void Trace::setThreadName( const char* name )
+{
+    threadBuffer()->mName.store( name );
+}
+
+bool Trace::save( const QString& path )
+{
+    QFile file( path );
+    if ( !file.open( QIODevice::WriteOnly|QIODevice::Truncate ) ) {
+        std::cout << "** Trace: can't write " << qPrintable(path) << ": " << qPrintable(file.errorString()) << std::endl;
+        return false;
+    }
+    QJsonObject trace;
+    trace.insert( "traceEvents", traceRegistry().toJson() );
+    trace.insert( "displayTimeUnit", "ms" );
+    return file.write( QJsonDocument( trace ).toJson( QJsonDocument::Compact ) ) >= 0;
+}
@@ -0,0 +1,81 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+
+/**
+ * @brief Scoped timing zones for building a cross-thread timeline.
+ * Each thread records completed zones into its own fixed size ring buffer without locking, so the oldest zones are
+ * overwritten once a buffer fills. The buffers are written out in Chrome's trace_event JSON format for viewing in
+ * chrome://tracing or Perfetto.
+ *
+ * Zones are placed with the TRACE_SCOPE macro, which compiles to nothing unless QLT_TRACE is defined (i.e. qmake
+ * CONFIG+=trace).
+ */
+class Trace
+{
+public:
+    // zones retained per thread
+    static constexpr unsigned BufferCapacity = 16384;
+
+    /**
+     * @brief Get the microseconds elapsed on the trace clock
+     */
+    static qint64 now();
+
+    /**
+     * @brief Record a completed zone for the calling thread
+     * @param name The zone name. Must remain valid for the life of the process (e.g. a string literal)
+     * @param start The zone's start time on the trace clock
+     * @param duration The zone's length in microseconds
+     */
+    static void record( const char* name, qint64 start, qint64 duration );
+
+    /**
+     * @brief Name the calling thread in the timeline
+     * @param name The thread name. Must remain valid for the life of the process (e.g. a string literal)
+     */
+    static void setThreadName( const char* name );
+
+    /**
+     * @brief Write the zones recorded by all threads as a Chrome trace_event JSON file
+     * @param path The file to write
+     * @return true if successful
+     */
+    static bool save( const QString& path );
+};
+
+/**
+ * @brief Records the lifetime of a scope as a trace zone
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope( const char* name ) : mName(name), mStart(Trace::now())
+    {
+    }
+
+    ~TraceScope()
+    {
+        Trace::record( mName, mStart, Trace::now() - mStart );
+    }
+
+    TraceScope( const TraceScope& ) = delete;
+    TraceScope& operator=( const TraceScope& ) = delete;
+
+private:
+    const char* mName;
+    qint64 mStart;
+};
+
+#ifdef QLT_TRACE
+#define TRACE_CONCAT_(a,b) a##b
+#define TRACE_CONCAT(a,b) TRACE_CONCAT_(a,b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope,__LINE__)( name )
+#define TRACE_THREAD_NAME(name) Trace::setThreadName( name )
+#else
+#define TRACE_SCOPE(name) ((void) 0)
+#define TRACE_THREAD_NAME(name) ((void) 0)
+#endif // QLT_TRACE
+
+#endif // TRACE_H
@@ -1,5 +1,8 @@
 #include <iostream>
+#include <algorithm>
 #include "workerthread.h"
+#include "perfstats.h"
+#include "trace.h"
 
 class SharedRunnableWrapper : public BasicRunnable
 {
@@ -18,11 +21,16 @@ public:
         return true;
     }
 
+    const char* getName() const override
+    {
+        return mSharedRunnable->getName();
+    }
+
 private:
     std::shared_ptr<Runnable> mSharedRunnable;
 };
 
-WorkerThread::WorkerThread() : mThread(nullptr), mShuttingDown(false)
+WorkerThread::WorkerThread() : mStats(nullptr), mThread(nullptr), mShuttingDown(false)
 {
 }
 
@@ -41,7 +49,10 @@ void WorkerThread::doWork( Runnable* runnable )
             mPendingMutex.lock();
         }
 
-        mPending.push_back( runnable );
+        mPending.push_back( { runnable, std::chrono::steady_clock::now() } );
+        if ( mStats ) {
+            mStats->record( PerfStats::WorkerQueueDepth, static_cast<qint64>( mPending.size() ) );
+        }
 
         if ( !mThread ) {
             mThread = new std::thread( [this] { run(); } );
@@ -77,12 +88,17 @@ void WorkerThread::purge()
     mShuttingDown = false;
 }
 
+void WorkerThread::setStats( PerfStats* stats )
+{
+    mStats = stats;
+}
+
 Runnable* WorkerThread::getCurrentRunnable()
 {
     std::lock_guard<std::mutex> guard(mPendingMutex);
 
     if ( !mPending.empty() ) {
-        return mPending.front();
+        return mPending.front().runnable;
     }
     return nullptr;
 }
@@ -91,6 +107,10 @@ void WorkerThread::dequeueCurrentRunnable()
 {
     std::lock_guard<std::mutex> guard(mPendingMutex);
 
+    if ( mStats ) {
+        auto latency = std::chrono::steady_clock::now() - mPending.front().queuedAt;
+        mStats->record( PerfStats::RunnableLatency, std::chrono::duration_cast<std::chrono::microseconds>( latency ).count() );
+    }
     mPending.pop_front();
 
 //    if ( mPending.size() ) {
@@ -100,8 +120,10 @@ void WorkerThread::dequeueCurrentRunnable()
 
 void WorkerThread::run()
 {
+    TRACE_THREAD_NAME( "worker" );
     while( Runnable* runnable = getCurrentRunnable() ) {
         if ( !mShuttingDown ) {
+            TRACE_SCOPE( runnable->getName() );
             runnable->runInternal();
         }
         dequeueCurrentRunnable();
@@ -111,3 +133,58 @@ void WorkerThread::run()
         }
     }
 }
+
+WorkerPool::WorkerPool( unsigned threadCount ) : mNext(0)
+{
+    if ( !threadCount ) {
+        threadCount = std::max( std::thread::hardware_concurrency(), 2U );
+    }
+    for( unsigned i = 0; i < threadCount; ++i ) {
+        mThreads.push_back( new WorkerThread() );
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    shutdown();
+    for( auto thread : mThreads ) {
+        delete thread;
+    }
+}
+
+unsigned WorkerPool::size() const
+{
+    return mThreads.size();
+}
+
+void WorkerPool::doWork( Runnable* runnable )
+{
+    mThreads[mNext++ % mThreads.size()]->doWork( runnable );
+}
+
+void WorkerPool::doWork( const std::shared_ptr<Runnable>& sharedRunnable )
+{
+    mThreads[mNext++ % mThreads.size()]->doWork( sharedRunnable );
+}
+
+void WorkerPool::shutdown()
+{
+    for( auto thread : mThreads ) {
+        thread->shutdown();
+    }
+}
+
+void WorkerPool::setStats( PerfStats* stats )
+{
+    for( auto thread : mThreads ) {
+        thread->setStats( stats );
+    }
+}
+
+void WorkerPool::purge()
+{
+    for( auto thread : mThreads ) {
+        thread->purge();
+    }
+    mNext = 0;
+}
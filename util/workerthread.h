@@ -1,13 +1,18 @@
 #ifndef WORKERTHREAD_H
 #define WORKERTHREAD_H
 
+#include <atomic>
+#include <chrono>
 #include <list>
+#include <vector>
 #include <mutex>
 #include <thread>
 #include <csetjmp>
 #include <memory>
 #include <cstring>
 
+class PerfStats;
+
 /**
  * @brief Interface for user-defined tasks
  */
@@ -31,6 +36,11 @@ public:
      * @return true to force deletion of this runnable after it is run by the WorkerThread
      */
     virtual bool deleteWhenDone() = 0;
+    /**
+     * @brief Get the name this task is traced as
+     * @return The name. Must remain valid for the life of the process (e.g. a string literal)
+     */
+    virtual const char* getName() const = 0;
 };
 
 /**
@@ -53,6 +63,11 @@ protected:
     {
         return false;
     }
+
+    const char* getName() const override
+    {
+        return "Runnable";
+    }
 };
 
 /**
@@ -148,15 +163,78 @@ public:
      */
     void purge();
 
+    /**
+     * @brief Record the queue depth and runnable latencies to the given stats. Must be set while idle.
+     */
+    void setStats( PerfStats* stats );
+
 private:
+    typedef struct {
+        Runnable* runnable;
+        std::chrono::steady_clock::time_point queuedAt;
+    } PendingRunnable;
+
     Runnable* getCurrentRunnable();
     void dequeueCurrentRunnable();
 
     void run();
     std::mutex mPendingMutex;
-    std::list<Runnable*> mPending;
+    std::list<PendingRunnable> mPending;
+    PerfStats* mStats;
     std::thread* mThread;
     bool mShuttingDown;
 };
 
+/**
+ * @brief A fixed set of worker threads for independent tasks which may run concurrently.
+ * Tasks are handed to the threads round-robin, so tasks that depend on one another belong on a single WorkerThread.
+ * Tasks may be queued from any thread.
+ */
+class WorkerPool
+{
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount The number of threads. 0 selects the hardware concurrency.
+     */
+    explicit WorkerPool( unsigned threadCount = 0 );
+    ~WorkerPool();
+
+    /**
+     * @brief Get the number of threads in this pool
+     */
+    unsigned size() const;
+
+    /**
+     * @brief Queue a task for execution. Ownership of the runnable is retained by the caller.
+     * @param runnable The task to queue
+     */
+    void doWork( Runnable* runnable );
+
+    /**
+     * @brief Queue a shared task for execution
+     * @param sharedRunnable
+     */
+    void doWork( const std::shared_ptr<Runnable>& sharedRunnable );
+
+    /**
+     * @brief Inform this pool that the app is shutting down
+     */
+    void shutdown();
+
+    /**
+     * @brief Forcibly return all threads to their initial state
+     */
+    void purge();
+
+    /**
+     * @brief Record the queue depths and runnable latencies of all threads to the given stats
+     */
+    void setStats( PerfStats* stats );
+
+private:
+    std::vector<WorkerThread*> mThreads;
+    std::atomic<unsigned> mNext; // the pool is shared so tasks may be queued from any thread
+};
+
 #endif // WORKERTHREAD_H
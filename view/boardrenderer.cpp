@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <QRect>
 #include <QPainter>
@@ -11,6 +12,83 @@
 
 const QPoint BoardRenderer::NullPoint = QPoint(-1,-1);
 
+// Find the first piece at or after the given square
+static PieceVector::const_iterator lowerBound( const PieceVector& pieces, int col, int row )
+{
+    return std::lower_bound( pieces.begin(), pieces.end(), Piece::encodePos( col, row ),
+                             []( const PushedPiece& piece, int pos ) { return piece.encodedPos() < pos; } );
+}
+
+static PieceMultiSet::const_iterator lowerBound( const PieceMultiSet& pieces, int col, int row )
+{
+    SimplePiece key( MOVE, col, row );
+    return pieces.lower_bound( &key );
+}
+
+static const Piece& pieceOf( const Piece* piece )
+{
+    return *piece;
+}
+
+static const Piece& pieceOf( const PushedPiece& piece )
+{
+    return piece;
+}
+
+template<class Iterator>
+static void renderRange( Iterator iterator, Iterator end, int pushIdDelineation, const BoardRenderer& renderer,
+                         const QRect* dirty, QPainter* painter )
+{
+    if ( pushIdDelineation < 0 ) {
+        while( iterator != end ) {
+            if ( !pieceOf( *iterator ).render( dirty, renderer, painter ) ) {
+                break;
+            }
+            ++iterator;
+        }
+    } else {
+        bool usingAlternateColor = false;
+        QPen savePen = painter->pen();
+
+        while( iterator != end ) {
+            const Piece& piece = pieceOf( *iterator );
+            if ( piece.getPushedId() <= pushIdDelineation ) {
+                if ( !usingAlternateColor ) {
+                    painter->setPen( Qt::blue );
+                    usingAlternateColor = true;
+                }
+            } else if ( usingAlternateColor ) {
+                painter->setPen( savePen );
+                usingAlternateColor = false;
+            }
+            if ( !piece.render( dirty, renderer, painter ) ) {
+                break;
+            }
+            ++iterator;
+        }
+
+        if ( usingAlternateColor ) {
+            painter->setPen( savePen );
+        }
+    }
+}
+
+// Render the pieces within the area one row at a time, skipping those in the columns outside of it
+template<class Container>
+static void renderRows( const Container& pieces, int pushIdDelineation, const BoardRenderer& renderer,
+                        const QRect* dirty, QPainter* painter )
+{
+    int tileSize = renderer.tileSize();
+    int minCol = std::max( dirty->left()  / tileSize, 0 );
+    int minRow = std::max( dirty->top()   / tileSize, 0 );
+    int maxCol = std::min( dirty->right() / tileSize, BoardMaxWidth-1 );
+    int maxRow = std::min( dirty->bottom()/ tileSize, BoardMaxHeight-1 );
+    for( int row = minRow; row <= maxRow; ++row ) {
+        renderRange( lowerBound( pieces, minCol, row ), lowerBound( pieces, maxCol+1, row ), pushIdDelineation,
+                     renderer, dirty, painter );
+    }
+}
+
 BoardRenderer::BoardRenderer( int tileSize ) : mTileSize(tileSize), mPushIdDelineation(-1)
 {
 }
@@ -34,55 +112,84 @@ void BoardRenderer::render( const QRect& rect, Board* board, QPainter* painter )
         for( int col = minCol; col <= maxCol; ++col ) {
             square.moveLeft( col * mTileSize );
 
-            TileType type = board->tileAt( ModelPoint(col,row) );
-            const QPixmap* pixmap = ResourcePixmap::getPixmap( type );
-            if ( !pixmap->isNull() ) {
-                painter->drawPixmap( square, *pixmap );
-            } else {
-                int angle = 0;
-                switch( type ) {
-                case STONE_MIRROR__90:
-                    pixmap = ResourcePixmap::getPixmap( STONE_MIRROR );
-                    angle = 90;
-                    break;
-                case STONE_MIRROR_180:
-                    pixmap = ResourcePixmap::getPixmap( STONE_MIRROR );
-                    angle = 180;
-                    break;
-                case STONE_MIRROR_270:
-                    pixmap = ResourcePixmap::getPixmap( STONE_MIRROR );
-                    angle = 270;
-                    break;
-                case STONE_SLIT_90:
-                    pixmap = ResourcePixmap::getPixmap( STONE_SLIT );
-                    angle = 90;
-                    break;
-                case WOOD_DAMAGED:
-                    BoardRenderer::renderPixmap( square, WOOD_DAMAGED, painter );
-                    break;
-                default: // EMPTY
-                    break;
-                }
-                if ( angle && pixmap ) {
-                    renderRotatedPixmap( pixmap, square, angle, painter );
+            unsigned type;
+            int angle;
+            if ( getTileDepiction( board->tileAt( ModelPoint(col,row) ), &type, &angle ) ) {
+                renderRotatedPixmap( ResourcePixmap::getPixmap( type ), square, angle, painter );
+            }
+        }
+    }
+
+    renderRows( board->getPieceManager().getPieces(), -1, *this, &rect, painter );
+}
+
+void BoardRenderer::render( Board* board, const TileImageSet& images, QPainter* painter ) const
+{
+    int width = board->getWidth();
+    int height = board->getHeight();
+    QPoint topLeft;
+    unsigned type;
+    int angle;
+
+    for( int row = 0; row < height; ++row ) {
+        topLeft.setY( row*mTileSize );
+
+        for( int col = 0; col < width; ++col ) {
+            topLeft.setX( col*mTileSize );
+
+            if ( getTileDepiction( board->tileAt( ModelPoint(col,row) ), &type, &angle ) ) {
+                if ( const QImage* image = images.get( type, angle ) ) {
+                    painter->drawImage( topLeft, *image );
                 }
             }
         }
     }
 
-    const PieceSet& pieces = board->getPieceManager().getPieces();
-    SimplePiece pos(MOVE, minCol, minRow);
-    for( auto iterator = pieces.lower_bound( &pos ); iterator != pieces.end(); ++iterator ) {
-        if ( !(*iterator)->render( &rect, *this, painter ) ) {
-            break;
+    for( const auto& piece : board->getPieceManager().getPieces() ) {
+        if ( const QImage* image = images.get( piece.getType(), piece.getAngle() ) ) {
+            painter->drawImage( QPoint( piece.mCol*mTileSize, piece.mRow*mTileSize ), *image );
         }
     }
+
+    const ModelVector& v = board->getTankStartVector();
+    if ( const QImage* image = images.get( TANK, v.mAngle ) ) {
+        painter->drawImage( QPoint( v.mCol*mTileSize, v.mRow*mTileSize ), *image );
+    }
+}
+
+bool BoardRenderer::getTileDepiction( TileType tile, unsigned* pixmapType, int* angle )
+{
+    *angle = 0;
+    switch( tile ) {
+    case STONE_MIRROR__90:
+        *pixmapType = STONE_MIRROR;
+        *angle = 90;
+        break;
+    case STONE_MIRROR_180:
+        *pixmapType = STONE_MIRROR;
+        *angle = 180;
+        break;
+    case STONE_MIRROR_270:
+        *pixmapType = STONE_MIRROR;
+        *angle = 270;
+        break;
+    case STONE_SLIT_90:
+        *pixmapType = STONE_SLIT;
+        *angle = 90;
+        break;
+    case EMPTY:
+        return false;
+    default:
+        *pixmapType = tile;
+        break;
+    }
+    return true;
 }
 
 void BoardRenderer::renderPixmap( QRect& square, unsigned type, QPainter* painter )
 {
-    if ( const QPixmap* pixmap = ResourcePixmap::getPixmap(type) ) {
-        painter->drawPixmap( square, *pixmap );
+    if ( const ResourcePixmap* pixmap = ResourcePixmap::getPixmap(type) ) {
+        renderRotatedPixmap( pixmap, square, 0, painter );
     } else {
         std::cout << "*** attempt to paint unlisted pixmap " << type << std::endl;
     }
@@ -98,14 +205,23 @@ void BoardRenderer::renderRotation( QRect& square, int angle, QPainter* painter
     painter->translate(-center.x(), -center.y());
 }
 
-void BoardRenderer::renderRotatedPixmap( const QPixmap* pixmap, QRect& square, int angle, QPainter* painter )
+void BoardRenderer::renderRotatedPixmap( const ResourcePixmap* pixmap, QRect& square, int angle, QPainter* painter,
+                                         const QColor* color )
 {
+    if ( square.width() == square.height() ) {
+        if ( const QPixmap* rotated = pixmap->getRotated( angle, square.width(), color ) ) {
+            painter->drawPixmap( square.topLeft(), *rotated );
+            return;
+        }
+    }
+
+    const QPixmap* pm = color ? pixmap->getForColor( *color ) : pixmap;
     if ( !angle ) {
-        painter->drawPixmap( square, *pixmap );
+        painter->drawPixmap( square, *pm );
     } else {
         QTransform save = painter->transform();
         BoardRenderer::renderRotation( square, angle, painter );
-        painter->drawPixmap( square, *pixmap );
+        painter->drawPixmap( square, *pm );
         painter->setTransform( save );
     }
 }
@@ -117,49 +233,22 @@ void BoardRenderer::renderPiece( PieceType type, QRect& square, int angle, QPain
         std::cout << "no pixmap for " << type << std::endl;
         return;
     }
-    const QPixmap* pm;
     if ( pixmap->hasColorableTag() ) {
-        pm = pixmap->getForColor( painter->pen().color() );
+        QColor color = painter->pen().color();
+        renderRotatedPixmap( pixmap, square, angle, painter, &color );
     } else {
-        pm = pixmap;
+        renderRotatedPixmap( pixmap, square, angle, painter );
     }
-
-    renderRotatedPixmap( pm, square, angle, painter );
 }
 
-void BoardRenderer::renderListIn( PieceSet::iterator iterator, PieceSet::iterator end, const QRect* dirty, QPainter* painter )
+void BoardRenderer::renderListIn( const PieceMultiSet& pieces, const QRect* dirty, QPainter* painter )
 {
-    if ( mPushIdDelineation < 0 ) {
-        while( iterator != end ) {
-            if ( !(*iterator)->render( dirty, *this, painter ) ) {
-                break;
-            }
-            ++iterator;
-        }
-    } else {
-        bool usingAlternateColor = false;
-        QPen savePen = painter->pen();
-
-        while( iterator != end ) {
-            if ( (*iterator)->getPushedId() <= mPushIdDelineation ) {
-                if ( !usingAlternateColor ) {
-                    painter->setPen( Qt::blue );
-                    usingAlternateColor = true;
-                }
-            } else if ( usingAlternateColor ) {
-                painter->setPen( savePen );
-                usingAlternateColor = false;
-            }
-            if ( !(*iterator)->render( dirty, *this, painter ) ) {
-                break;
-            }
-            ++iterator;
-        }
+    renderRows( pieces, mPushIdDelineation, *this, dirty, painter );
+}
 
-        if ( usingAlternateColor ) {
-            painter->setPen( savePen );
-        }
-    }
+void BoardRenderer::renderListIn( const PieceVector& pieces, const QRect* dirty, QPainter* painter )
+{
+    renderRows( pieces, mPushIdDelineation, *this, dirty, painter );
 }
 
 void BoardRenderer::setPushIdDelineation( int pushIdDelineation )
@@ -183,21 +272,32 @@ QRect* BoardRenderer::getBounds( const ModelPoint& forPoint, QRect* rect ) const
 void BoardRenderer::renderMoves( const QRect& rect, GameRegistry* registry, QPainter* painter )
 {
     MoveController& moveController = registry->getMoveController();
-    SimplePiece pos(MOVE, rect.left()/mTileSize, rect.top()/mTileSize);
-    moveController.render( &pos, &rect, *this, painter );
+    moveController.render( &rect, *this, painter );
     if ( !moveController.replaying() ) {
-        if ( const PieceSet* deltas = registry->getGame().getDeltaPieces() ) {
+        if ( const PieceVector* deltas = registry->getGame().getDeltaPieces() ) {
             int pushIdDelineation = moveController.getPushIdDelineation();
             if ( pushIdDelineation < 0 ) {
                 QPen savePen( painter->pen() );
                 painter->setPen( Qt::blue );
-                renderListIn( deltas->lower_bound( &pos ), deltas->end(), &rect, painter );
+                renderListIn( *deltas, &rect, painter );
                 painter->setPen( savePen );
             } else {
                 setPushIdDelineation( pushIdDelineation );
-                renderListIn( deltas->lower_bound( &pos ), deltas->end(), &rect, painter );
+                renderListIn( *deltas, &rect, painter );
                 setPushIdDelineation( -1 );
             }
+
+            // mark the planned tiles which can no longer reach water
+            Board* futureBoard = registry->getGame().getBoard( true );
+            QPen savePen( painter->pen() );
+            painter->setPen( Qt::red );
+            for( const auto& delta : *deltas ) {
+                if ( delta.getType() == TILE_FUTURE_INSERT && futureBoard->isDeadSquare( delta )
+                  && futureBoard->getPieceManager().typeAt( delta ) == TILE ) {
+                    delta.render( &rect, *this, painter );
+                }
+            }
+            painter->setPen( savePen );
         }
     }
 }
@@ -4,12 +4,16 @@
 #include <QPoint>
 #include "model/modelpoint.h"
 #include "model/piece.h"
+#include "model/tile.h"
 
 QT_FORWARD_DECLARE_CLASS(QRect)
 QT_FORWARD_DECLARE_CLASS(QPainter)
+QT_FORWARD_DECLARE_CLASS(QColor)
 
 class Board;
 class GameRegistry;
+class ResourcePixmap;
+class TileImageSet;
 
 /**
  * @brief A light-weight helper class for rendering boards for a specific tile size
@@ -24,6 +28,24 @@ public:
     void render( const QRect& rect, Board* board, QPainter* painter ) const;
     void renderInitialTank( Board* board, QPainter* painter );
 
+    /**
+     * @brief Render the whole board including its initial tank from pre-rendered images.
+     * Unlike render, this may be used from a background thread (e.g. when painting into a QImage)
+     * @param board The board to render
+     * @param images Images at this renderer's tile size
+     * @param painter The painter to use
+     */
+    void render( Board* board, const TileImageSet& images, QPainter* painter ) const;
+
+    /**
+     * @brief Get how the given tile type is depicted
+     * @param tile The tile type
+     * @param pixmapType Returns the identifier of the image to paint
+     * @param angle Returns the rotation to paint the image at
+     * @return false if the tile is not painted (I.e. EMPTY)
+     */
+    static bool getTileDepiction( TileType tile, unsigned* pixmapType, int* angle );
+
     /**
      * @brief Gets the rectangular screen area for the given model point
      * @param forPoint The point to obtain the area of
@@ -50,12 +72,15 @@ public:
 
     /**
      * @brief Paint the pixmap at the given location with the given rotation
+     * Right angles are painted from the pixmap's pre-rotated variants; other angles fall back to a painter transform.
      * @param pixmap The image to paint
      * @param square The bounding rectangle of the board position to transform to
      * @param angle The rotation
      * @param painter The painter to apply to
+     * @param color If non-null, selects the pixmap's color variant
      */
-    static void renderRotatedPixmap( const QPixmap* pixmap, QRect& square, int angle, QPainter* painter );
+    static void renderRotatedPixmap( const ResourcePixmap* pixmap, QRect& square, int angle, QPainter* painter,
+                                     const QColor* color = nullptr );
 
     /**
      * @brief Paint the piece type at the given location with the given rotation
@@ -67,13 +92,14 @@ public:
     static void renderPiece( PieceType type, QRect& square, int angle, QPainter* painter );
 
     /**
-     * @brief Helper method to render the given set within the given rectangular area
-     * @param iterator The starting position within the set
-     * @param end The end of set position
+     * @brief Helper method to render the pieces of the given set which lie within the given rectangular area
+     * Only the pieces within the columns spanned by the area are visited on each of its rows.
+     * @param pieces The position ordered pieces
      * @param dirty The rectangular area being rendered
      * @param painter The painter associated with this render operation
      */
-    void renderListIn( PieceSet::iterator iterator, PieceSet::iterator end, const QRect* dirty, QPainter* painter );
+    void renderListIn( const PieceMultiSet& pieces, const QRect* dirty, QPainter* painter );
+    void renderListIn( const PieceVector& pieces, const QRect* dirty, QPainter* painter );
 
     void renderMoves( const QRect& rect, GameRegistry* registry , QPainter *painter );
 
@@ -4,6 +4,10 @@
 #include <QStatusBar>
 #include <QTextBrowser>
 #include <QWhatsThis>
+#include <QScreen>
+#include <QFileDialog>
+#include <QDir>
+#include <QElapsedTimer>
 
 #include "boardwindow.h"
 #include "boardrenderer.h"
@@ -18,9 +22,18 @@
 #include "model/shotmodel.h"
 #include "model/level.h"
 #include "view/levelchooser.h"
+#include "view/thumbnailcache.h"
 #include "util/recorder.h"
 #include "util/imageutils.h"
 #include "util/helputils.h"
+#include "util/perfstats.h"
+#include "util/trace.h"
+
+// lines of text in the performance overlay
+static const int OverlayLines = 5;
+
+// milliseconds between performance overlay refreshes
+static const int OverlayRefreshInterval = 500;
 
 
 /**
@@ -29,10 +42,14 @@
  */
 int checkForReplay( GameRegistry* registry );
 
-BoardWidget::BoardWidget(QWidget* parent) : QWidget(parent), mForbiddenCursor{nullptr}
+BoardWidget::BoardWidget(QWidget* parent) : QWidget(parent), mStaticLayer(TILE_SIZE), mForbiddenCursor{nullptr},
+  mOverlayVisible{false}
 {
     setAttribute( Qt::WA_OpaquePaintEvent );
     setSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed );
+
+    mOverlayTimer.setInterval( OverlayRefreshInterval );
+    QObject::connect( &mOverlayTimer, &QTimer::timeout, this, &BoardWidget::refreshOverlay );
 }
 
 BoardWidget::~BoardWidget()
@@ -45,12 +62,7 @@ void BoardWidget::init( GameRegistry* registry )
     Game& game = registry->getGame();
     QObject::connect( &game, &Game::boardLoaded, this, &BoardWidget::onBoardLoaded, Qt::DirectConnection );
 
-    Board* board = game.getBoard();
-    QObject::connect( board, &Board::tileChangedAt, this, &BoardWidget::renderSquareLater, Qt::DirectConnection );
-
-    PieceSetManager& pm = board->getPieceManager();
-    QObject::connect( &pm, &PieceSetManager::erasedAt,   this, &BoardWidget::renderSquareLater, Qt::DirectConnection );
-    QObject::connect( &pm, &PieceSetManager::insertedAt, this, &BoardWidget::renderSquareLater, Qt::DirectConnection );
+    QObject::connect( game.getBoard(), &Board::changesCommitted, this, &BoardWidget::invalidateChanges, Qt::DirectConnection );
 
     MoveController& moveController = registry->getMoveController();
     QObject::connect( &moveController, &MoveController::dragStateChanged, this, &BoardWidget::setCursorDragState );
@@ -65,23 +77,103 @@ void BoardWidget::init( GameRegistry* registry )
     QObject::connect( &registry->getShotPush(),               &Push::rectDirty,     this, &BoardWidget::renderLater, Qt::DirectConnection );
     QObject::connect( &moveController.getFutureShots(), &FutureShotPathManager::dirtyRect, this, &BoardWidget::renderLater, Qt::DirectConnection );
 
+    void (QWidget::*updateRect)(const QRect&) = &QWidget::update;
+    QObject::connect( &mRepaintScheduler, &RepaintScheduler::updateRequested, this, updateRect, Qt::DirectConnection );
+    if ( QScreen* screen = QGuiApplication::primaryScreen() ) {
+        if ( screen->refreshRate() > 0 ) {
+            mRepaintScheduler.setFrameInterval( qRound( 1000 / screen->refreshRate() ) );
+        }
+    }
+
     mWhatsThisAction.setText( "What's this?" );
 }
 
+RepaintScheduler& BoardWidget::getRepaintScheduler()
+{
+    return mRepaintScheduler;
+}
+
+void BoardWidget::setOverlayVisible( bool visible )
+{
+    if ( visible != mOverlayVisible ) {
+        mOverlayVisible = visible;
+        if ( visible ) {
+            mOverlayTimer.start();
+        } else {
+            mOverlayTimer.stop();
+        }
+        mRepaintScheduler.schedule( getOverlayRect() );
+    }
+}
+
+bool BoardWidget::isOverlayVisible() const
+{
+    return mOverlayVisible;
+}
+
+void BoardWidget::refreshOverlay()
+{
+    mRepaintScheduler.schedule( getOverlayRect() );
+}
+
+QRect BoardWidget::getOverlayRect() const
+{
+    QFontMetrics metrics( font() );
+    return QRect( 0, 0, metrics.horizontalAdvance( "persist 0000.00 ms 000000 px" ) + 8, metrics.height() * OverlayLines + 8 )
+      .intersected( rect() );
+}
+
+static QString formatMillis( qint64 micros )
+{
+    return QString::number( micros / 1000.0, 'f', 2 );
+}
+
+void BoardWidget::renderOverlay( const PerfStats& stats, QPainter* painter )
+{
+    PerfStats::Counter paintTime   = stats.get( PerfStats::PaintTime );
+    PerfStats::Counter paintArea   = stats.get( PerfStats::PaintArea );
+    PerfStats::Counter queueDepth  = stats.get( PerfStats::WorkerQueueDepth );
+    PerfStats::Counter latency     = stats.get( PerfStats::RunnableLatency );
+    PerfStats::Counter searchTime  = stats.get( PerfStats::PathSearchTime );
+    PerfStats::Counter expanded    = stats.get( PerfStats::PathSearchExpanded );
+    PerfStats::Counter shotSteps   = stats.get( PerfStats::ShotTraceSteps );
+    PerfStats::Counter persistTime = stats.get( PerfStats::PersistTime );
+
+    const QString lines[OverlayLines] = {
+        QString( "paint %1 ms %2 px" ).arg( formatMillis( paintTime.last ) ).arg( paintArea.last ),
+        QString( "worker q%1 %2 ms" ).arg( queueDepth.last ).arg( formatMillis( latency.last ) ),
+        QString( "path %1 ms %2 cells" ).arg( formatMillis( searchTime.last ) ).arg( expanded.last ),
+        QString( "shot %1 steps" ).arg( shotSteps.last ),
+        QString( "persist %1 ms" ).arg( formatMillis( persistTime.last ) )
+    };
+
+    QRect overlay = getOverlayRect();
+    painter->fillRect( overlay, QColor( 0, 0, 0, 160 ) );
+    painter->setPen( Qt::white );
+    int lineHeight = painter->fontMetrics().height();
+    int y = overlay.top() + 4 + painter->fontMetrics().ascent();
+    for( const QString& line : lines ) {
+        painter->drawText( overlay.left() + 4, y, line );
+        y += lineHeight;
+    }
+}
+
 void BoardWidget::paintEvent( QPaintEvent* e )
 {
+    TRACE_SCOPE( "BoardWidget::paintEvent" );
     if ( isVisible() ) {
         if ( GameRegistry* registry = getRegistry(this) ) {
+            QElapsedTimer paintTimer;
+            paintTimer.start();
             QPainter painter(this);
 
-            Board* board = registry->getGame().getBoard();
             Tank& tank = registry->getTank();
             MoveController& moveController = registry->getMoveController();
 
             if ( registry->getGame().isBoardLoaded() ) {
                 BoardRenderer renderer(TILE_SIZE);
-                painter.fillRect( e->rect(), Qt::black );
-                renderer.render( e->rect(), board, &painter );
+                mStaticLayer.refresh( registry->getGame().getBoard() );
+                mStaticLayer.paint( e->region(), &painter );
 
                 bool tankIsProminent = moveController.getFocus() != TANK && moveController.getDragState() == Inactive;
                 if ( tankIsProminent && moveController.getDragState() != Inactive ) {
@@ -106,6 +198,18 @@ void BoardWidget::paintEvent( QPaintEvent* e )
 
                 mDragMarker.render( &e->rect(), &painter );
                 registry->getCannonShot().render( &painter );
+
+                mRepaintScheduler.recordPainted( e->region() );
+
+                PerfStats& stats = registry->getPerfStats();
+                // the overlay refreshes itself periodically; keep its own repaints out of the counters it displays
+                if ( !mOverlayVisible || !getOverlayRect().contains( e->region().boundingRect() ) ) {
+                    stats.record( PerfStats::PaintTime, paintTimer.nsecsElapsed() / 1000 );
+                    stats.record( PerfStats::PaintArea, mRepaintScheduler.getLastFrameStats().pixelCount );
+                }
+                if ( mOverlayVisible && e->region().intersects( getOverlayRect() ) ) {
+                    renderOverlay( stats, &painter );
+                }
             }
         }
     }
@@ -129,22 +233,33 @@ void BoardWidget::onBoardLoaded()
         int w = board->getWidth() * TILE_SIZE;
         int h = board->getHeight()  * TILE_SIZE;
         setFixedSize( w, h );
-        update( 0, 0, w, h );
+        mStaticLayer.reset( w, h );
+        mRepaintScheduler.schedule( QRect( 0, 0, w, h ) );
     }
 }
 
 void BoardWidget::renderLater( const QRect& rect )
 {
-    update( rect );
+    mRepaintScheduler.schedule( rect );
 }
 
 void BoardWidget::renderSquareLater( ModelPoint point )
 {
-    update(point.mCol*TILE_SIZE, point.mRow*TILE_SIZE, TILE_SIZE, TILE_SIZE);
+    mRepaintScheduler.schedule( QRect( point.mCol*TILE_SIZE, point.mRow*TILE_SIZE, TILE_SIZE, TILE_SIZE ) );
+}
+
+void BoardWidget::invalidateChanges( const BoardChangeSet& changes )
+{
+    QRect region( changes.mTopLeft.mCol*TILE_SIZE, changes.mTopLeft.mRow*TILE_SIZE,
+                  (changes.mBottomRight.mCol - changes.mTopLeft.mCol + 1) * TILE_SIZE,
+                  (changes.mBottomRight.mRow - changes.mTopLeft.mRow + 1) * TILE_SIZE );
+    mStaticLayer.invalidate( region );
+    mRepaintScheduler.schedule( region );
 }
 
 BoardWindow::BoardWindow(QWidget* parent) : QMainWindow(parent), mMoveCounter(new WhatsThisAwareLabel(this)),
   mSavedMoveCount(new WhatsThisAwareLabel(this)), mCompletedIndicator(new WhatsThisAwareLabel(this)),
+  mRateIndicator(new WhatsThisAwareLabel(this)), mStrandedIndicator(new WhatsThisAwareLabel(this)),
   mGameInitialized{false}, mHelpWidget{nullptr}, mReplayText{nullptr}, mBackdoorCode{0}
 {
     setCentralWidget( new BoardWidget(this) );
@@ -168,6 +283,11 @@ void BoardWindow::init( GameRegistry* registry )
     QObject::connect( &mUndoMoveAction,  &QAction::triggered, &moveController, &MoveController::undoLastMove );
     QObject::connect( &mClearMovesAction,&QAction::triggered, &moveController, &MoveController::undoMoves    );
     QObject::connect( &mReplayAction,    &QAction::triggered, &game, &Game::replayLevel );
+    QObject::connect( &mTurboReplayAction, &QAction::triggered, &game, &Game::turboReplayLevel );
+
+    mOverlayAction.setCheckable(true);
+    BoardWidget* boardWidget = static_cast<BoardWidget*>( centralWidget() );
+    QObject::connect( &mOverlayAction, &QAction::toggled, boardWidget, &BoardWidget::setOverlayVisible );
 
     QObject::connect( &game, &Game::boardLoaded, this, &BoardWindow::onBoardLoaded, Qt::DirectConnection );
 
@@ -199,6 +319,22 @@ void BoardWindow::init( GameRegistry* registry )
         mMoveCounter->setWhatsThis( "Current move count. Shows the number of moves taken so far" );
         status->addWidget( mMoveCounter );
 
+        GameClock& clock = registry->getSpeedController().getClock();
+        QObject::connect( &registry->getSpeedController(), &SpeedController::speedMultiplierChanged, this, &BoardWindow::onClockChanged );
+        QObject::connect( &clock, &GameClock::turboChanged,     this, &BoardWindow::onClockChanged );
+        QObject::connect( &clock, &GameClock::tickRateMeasured, this, &BoardWindow::onClockChanged );
+        mRateIndicator->setStyleSheet( "* { color: gray; }" );
+        mRateIndicator->setWhatsThis( "Speed multiplier. Shows the achieved versus the requested game steps per second" );
+        mRateIndicator->setVisible( false );
+        status->addWidget( mRateIndicator );
+
+        QObject::connect( &game, &Game::tileStranded, this, &BoardWindow::onTileStranded );
+        mStrandedIndicator->setText( "STRANDED" );
+        mStrandedIndicator->setStyleSheet( "* { color: red; }" );
+        mStrandedIndicator->setWhatsThis( "Stranded tile indicator. Shows a tile has been pushed where it can never reach water" );
+        mStrandedIndicator->setVisible( false );
+        status->addWidget( mStrandedIndicator );
+
         QObject::connect( &registry->getLevelList(), &LevelList::levelUpdated, this, &BoardWindow::onLevelUpdated );
         if( const QPixmap* pm = ResourcePixmap::getPixmap(COMPLETE_CHECKMARK) ) {
             mCompletedIndicator->setPixmap( *pm );
@@ -234,6 +370,15 @@ void BoardWindow::onBoardLoaded()
 
     mSavedMoveCount->setVisible(completedVisible);
     mCompletedIndicator->setVisible(completedVisible);
+    mStrandedIndicator->setVisible(false);
+}
+
+void BoardWindow::onTileStranded( const ModelPoint& /*point*/, bool futuristic )
+{
+    // planned pushes are marked on the board as they are planned
+    if ( !futuristic ) {
+        mStrandedIndicator->setVisible(true);
+    }
 }
 
 void BoardWindow::onLevelUpdated( const QModelIndex& index )
@@ -267,7 +412,7 @@ void BoardWindow::showHelp()
 void BoardWindow::chooseLevel()
 {
     if ( GameRegistry* registry = getRegistry(this) ) {
-        auto chooser = new LevelChooser( registry->getLevelList(), registry->getBoardPool() );
+        auto chooser = new LevelChooser( registry->getLevelList(), registry->getBoardPool(), registry->getThumbnailCache() );
         chooser->setAttribute( Qt::WA_DeleteOnClose );
         QObject::connect( chooser, &LevelChooser::levelChosen, this, &BoardWindow::loadLevel );
 
@@ -344,6 +489,8 @@ QAction* BoardWindow::showMenu( QPoint* globalPos, const QList<QAction*> widgetA
             captureAction.setText( "&Capture Flag" );
             mReloadAction.setText( "&Restart Level" );
             mReplayAction.setText( "&Auto Replay" );
+            mTurboReplayAction.setText( "&Turbo Replay" );
+            mOverlayAction.setText( "&Performance Overlay" );
 
             mSpeedAction.setShortcut( Qt::Key_S );
             captureAction.setShortcut( Qt::Key_C );
@@ -351,6 +498,8 @@ QAction* BoardWindow::showMenu( QPoint* globalPos, const QList<QAction*> widgetA
             mClearMovesAction.setShortcut( Qt::CTRL|Qt::Key_Backspace );
             mReloadAction.setShortcut( Qt::ALT|Qt::Key_R );
             mReplayAction.setShortcut( Qt::ALT|Qt::Key_A );
+            mTurboReplayAction.setShortcut( Qt::ALT|Qt::Key_T );
+            mOverlayAction.setShortcut( Qt::ALT|Qt::Key_P );
 
             mMenu.addSeparator(); // separate contextual actions (above) and non-contextual (below)
             mMenu.addAction( "shoot& ", &registry->getMoveController(), SLOT(fire()), Qt::Key_Space );
@@ -361,6 +510,12 @@ QAction* BoardWindow::showMenu( QPoint* globalPos, const QList<QAction*> widgetA
             mMenu.addAction( &mReloadAction     );
             mMenu.addAction( "Select &Level..", this, SLOT(chooseLevel()), Qt::ALT|Qt::Key_L );
             mMenu.addAction( &mReplayAction );
+            mMenu.addAction( &mTurboReplayAction );
+            mMenu.addAction( &mOverlayAction );
+            mMenu.addAction( "&Export Statistics..", this, SLOT(exportStats()), Qt::ALT|Qt::Key_E );
+#ifdef QLT_TRACE
+            mMenu.addAction( "Export T&race..", this, SLOT(exportTrace()) );
+#endif // QLT_TRACE
             mMenu.addAction( "&Help", this, SLOT(showHelp()) );
             mMenu.addAction( "About Qt", qApp, &QApplication::aboutQt );
             mMenu.addAction( "E&xit", this, SLOT(close()) );
@@ -385,6 +540,7 @@ QAction* BoardWindow::showMenu( QPoint* globalPos, const QList<QAction*> widgetA
         mClearMovesAction.setEnabled( movesPending );
         bool modified = !registry->getRecorder().isEmpty();
         mReplayAction.setEnabled( modified || registry->getLevelList().isLevelCompleted( board->getLevel() ) );
+        mTurboReplayAction.setEnabled( mReplayAction.isEnabled() );
         mReloadAction.setEnabled( modified );
 
         mMenu.insertActions( mMenu.actions().at(0), widgetActions );
@@ -443,7 +599,7 @@ void BoardWindow::keyPressEvent(QKeyEvent *ev)
                 if ( !checkForReplay(registry) && registry->getMoveController().getDragState() == Inactive )  {
                     PathSearchAction& captureAction = registry->getCaptureAction();
                     Board* board = registry->getGame().getBoard();
-                    captureAction.setCriteria( registry->getMoveController().getFocus(), board->getFlagPoint() );
+                    captureAction.setCriteria( registry->getMoveController().getFocus(), board->getFlagPoint(), PlayerPathPushBudget );
                     registry->getPathFinderController().doAction( &captureAction );
                 }
                 break;
@@ -452,6 +608,15 @@ void BoardWindow::keyPressEvent(QKeyEvent *ev)
                 mBackdoorCode = 0;
                 break;
 
+            case Qt::Key_Plus:
+            case Qt::Key_Equal:
+                registry->getSpeedController().stepSpeedMultiplier( true );
+                break;
+
+            case Qt::Key_Minus:
+                registry->getSpeedController().stepSpeedMultiplier( false );
+                break;
+
             default:
                 int rotation = keyToAngle(ev->key());
                 if ( rotation >= 0 ) {
@@ -502,12 +667,30 @@ void BoardWindow::keyReleaseEvent( QKeyEvent* ev )
                 }
                 break;
 
+            case Qt::Key_T:
+                if ( ev->modifiers() == Qt::AltModifier ) {
+                    registry->getGame().turboReplayLevel();
+                }
+                break;
+
             case Qt::Key_L:
                 if ( ev->modifiers() == Qt::AltModifier ) {
                     chooseLevel();
                 }
                 break;
 
+            case Qt::Key_P:
+                if ( ev->modifiers() == Qt::AltModifier ) {
+                    mOverlayAction.toggle();
+                }
+                break;
+
+            case Qt::Key_E:
+                if ( ev->modifiers() == Qt::AltModifier ) {
+                    exportStats();
+                }
+                break;
+
             case Qt::Key_R:
                 if ( ev->modifiers() == Qt::AltModifier ) {
                     registry->getGame().restartLevel();
@@ -567,7 +750,7 @@ void BoardWidget::mousePressEvent( QMouseEvent* event )
 
                 QPoint globalPos = event->globalPos();
                 ModelPoint p( event->pos() );
-                if ( p.mCol >= 0 && pathToAction.setCriteria( registry->getMoveController().getFocus(), p ) ) {
+                if ( p.mCol >= 0 && pathToAction.setCriteria( registry->getMoveController().getFocus(), p, PlayerPathPushBudget ) ) {
                     myActions.append( &pathToAction );
                 }
 
@@ -701,6 +884,42 @@ void BoardWidget::setCursorDragState( DragState state )
     }
 }
 
+void BoardWindow::onClockChanged()
+{
+    if ( GameRegistry* registry = getRegistry(this) ) {
+        GameClock& clock = registry->getSpeedController().getClock();
+        if ( clock.getTurbo() ) {
+            mRateIndicator->setText( QString( "turbo %1 steps/s" ).arg( clock.getAchievedTickRate() ) );
+        } else {
+            mRateIndicator->setText( QString( "%1x %2/%3 steps/s" ).arg( clock.getRate() )
+                                     .arg( clock.getAchievedTickRate() ).arg( clock.getRequestedTickRate() ) );
+        }
+        mRateIndicator->setVisible( clock.getTurbo() || clock.getRate() != 1 );
+    }
+}
+
+void BoardWindow::exportStats()
+{
+    if ( GameRegistry* registry = getRegistry(this) ) {
+        QString path = QFileDialog::getSaveFileName( this, "Export Statistics",
+          QDir::home().absoluteFilePath( "qltstats.json" ), "JSON (*.json)" );
+        if ( !path.isEmpty() ) {
+            registry->getPerfStats().save( path );
+        }
+    }
+}
+
+#ifdef QLT_TRACE
+void BoardWindow::exportTrace()
+{
+    QString path = QFileDialog::getSaveFileName( this, "Export Trace", QDir::home().absoluteFilePath( "qlttrace.json" ),
+      "Chrome trace (*.json)" );
+    if ( !path.isEmpty() ) {
+        Trace::save( path );
+    }
+}
+#endif // QLT_TRACE
+
 void BoardWindow::onRecordedCountChanged()
 {
     if ( GameRegistry* registry = getRegistry(this) ) {
@@ -15,10 +15,14 @@ class Board;
 class GameRegistry;
 class Game;
 class ReplayText;
+class PerfStats;
 
 #include "tiledragmarker.h"
+#include "repaintscheduler.h"
+#include "staticboardlayer.h"
 #include "whatsthisaware.h"
 #include "controller/movecontroller.h"
+#include "model/board.h"
 #include "model/piece.h"
 
 
@@ -35,6 +39,14 @@ public:
     void paintEvent( QPaintEvent* e ) override;
     QSize sizeHint() const override;
 
+    RepaintScheduler& getRepaintScheduler();
+
+    /**
+     * @brief Show or hide the performance overlay
+     */
+    void setOverlayVisible( bool visible );
+    bool isOverlayVisible() const;
+
 public slots:
     /**
      * @brief mark a rectangular area as dirty
@@ -47,8 +59,15 @@ public slots:
      */
     void renderSquareLater( ModelPoint point );
 
+    /**
+     * @brief mark the region of the given board changes as stale in the static board layer. The region is re-rendered
+     * into the layer on the next paint
+     */
+    void invalidateChanges( const BoardChangeSet& changes );
+
 private slots:
     void onBoardLoaded();
+    void refreshOverlay();
 
 protected:
     void mousePressEvent( QMouseEvent* event ) override;
@@ -62,9 +81,23 @@ private:
      */
     void setCursorDragState( DragState state );
 
+    /**
+     * @brief Get the area the performance overlay occupies
+     */
+    QRect getOverlayRect() const;
+
+    /**
+     * @brief Draw the performance counters over the board
+     */
+    void renderOverlay( const PerfStats& stats, QPainter* painter );
+
+    StaticBoardLayer mStaticLayer;
+    RepaintScheduler mRepaintScheduler;
     TileDragMarker mDragMarker;
     QCursor* mForbiddenCursor;
     QAction mWhatsThisAction;
+    bool mOverlayVisible;
+    QTimer mOverlayTimer;
 };
 
 /**
@@ -122,6 +155,11 @@ private slots:
      */
     void onLevelUpdated( const QModelIndex& index );
 
+    /**
+     * @brief Listens for tiles pushed where they can never reach water
+     */
+    void onTileStranded( const ModelPoint& point, bool futuristic );
+
     /**
      * @brief Display the game help
      */
@@ -143,6 +181,23 @@ private slots:
      */
     void onRecordedCountChanged();
 
+    /**
+     * @brief Recieves notification that the game clock's rate or measurement changed
+     */
+    void onClockChanged();
+
+    /**
+     * @brief Save a snapshot of the performance counters to a file chosen by the user
+     */
+    void exportStats();
+
+#ifdef QLT_TRACE
+    /**
+     * @brief Save the timeline trace to a file chosen by the user
+     */
+    void exportTrace();
+#endif // QLT_TRACE
+
 protected:
     /**
      * @brief Window event handlers
@@ -157,10 +212,14 @@ private:
     QAction mUndoMoveAction;
     QAction mClearMovesAction;
     QAction mReplayAction;
+    QAction mTurboReplayAction;
+    QAction mOverlayAction;
 
     QLabel* mMoveCounter;
     QLabel* mSavedMoveCount;
     QLabel* mCompletedIndicator;
+    QLabel* mRateIndicator;
+    QLabel* mStrandedIndicator;
 
     QRegion mDirtyRegion;
     QRegion mRenderRegion;
@@ -8,6 +8,7 @@
 #include "boardrenderer.h"
 #include "model/board.h"
 #include "model/boardpool.h"
+#include "thumbnailcache.h"
 #include "util/imageutils.h"
 
 #define PADDING_WIDTH  3
@@ -16,7 +17,8 @@
 class LevelPainter : public QStyledItemDelegate
 {
 public:
-    explicit LevelPainter( BoardPool& pool, QObject* parent = nullptr ) : QStyledItemDelegate(parent), mPool(pool)
+    explicit LevelPainter( BoardPool& pool, ThumbnailCache& thumbnails, QObject* parent = nullptr ) : QStyledItemDelegate(parent),
+      mPool(pool), mThumbnails(thumbnails)
     {
     }
 
@@ -35,7 +37,12 @@ public:
         QRect rect( 0, 0, option.rect.width(), option.rect.height() );
 
         Level level = qvariant_cast<Level>( index.model()->data( index ) );
-        if ( Board* board = mPool.getBoard( level.getNumber() ) ) {
+        if ( const QImage* image = mThumbnails.getThumbnail( level.getNumber() ) ) {
+            QPoint offset( std::max( (rect.width()  - image->width()) /2, PADDING_WIDTH  ),
+                           std::max( (rect.height() - image->height())/2, PADDING_HEIGHT ) );
+            painter->drawImage( offset, *image );
+        } else if ( Board* board = mPool.getBoard( level.getNumber() ) ) {
+            // render live until the thumbnail arrives:
             BoardRenderer renderer( ChooserTileSize );
             QPoint offset( std::max( (rect.width()  - board->getWidth() *ChooserTileSize)/2, PADDING_WIDTH  ),
                            std::max( (rect.height() - board->getHeight()*ChooserTileSize)/2, PADDING_HEIGHT ) );
@@ -62,9 +69,10 @@ public:
 
 private:
     BoardPool& mPool;
+    ThumbnailCache& mThumbnails;
 };
 
-LevelChooser::LevelChooser( LevelList& levels, BoardPool& pool, QWidget* parent ) : QListView(parent)
+LevelChooser::LevelChooser( LevelList& levels, BoardPool& pool, ThumbnailCache& thumbnails, QWidget* parent ) : QListView(parent)
 {
     setWindowFlags( Qt::Dialog );
     setWindowTitle( "Select Level" );
@@ -80,10 +88,11 @@ LevelChooser::LevelChooser( LevelList& levels, BoardPool& pool, QWidget* parent
 
     setModel( &levels );
 
-    setItemDelegate( new LevelPainter( pool, this ) );
+    setItemDelegate( new LevelPainter( pool, thumbnails, this ) );
 
     QObject::connect( this, &LevelChooser::activated, this, &LevelChooser::onActivated );
     QObject::connect( &pool, &BoardPool::boardLoaded, this, &LevelChooser::onBoardLoaded );
+    QObject::connect( &thumbnails, &ThumbnailCache::thumbnailReady, this, &LevelChooser::onBoardLoaded );
     QObject::connect( &levels, SIGNAL(levelUpdated(const QModelIndex&)), this, SLOT(update(const QModelIndex&)), Qt::QueuedConnection );
 }
 
@@ -8,13 +8,14 @@
 constexpr int ChooserTileSize = 12;
 
 class BoardPool;
+class ThumbnailCache;
 
 class LevelChooser : public QListView
 {
     Q_OBJECT
 
 public:
-    explicit LevelChooser( LevelList& levels, BoardPool& pool, QWidget* parent = nullptr );
+    explicit LevelChooser( LevelList& levels, BoardPool& pool, ThumbnailCache& thumbnails, QWidget* parent = nullptr );
 
     /**
      * @brief Query the display size of the list contents
@@ -41,7 +41,7 @@ void PieceView::setAngle( int angle )
     mAngle = angle;
 }
 
-bool PieceView::render( const QRect* dirty, const BoardRenderer& renderer, QPainter* painter )
+bool PieceView::render( const QRect* dirty, const BoardRenderer& renderer, QPainter* painter ) const
 {
     QRect bounds;
     renderer.getBounds( *this, &bounds );
@@ -50,7 +50,7 @@ public:
      * @param painter The painter
      * @return true if painted or false if outside of the dirty area
      */
-    bool render( const QRect* dirty, const BoardRenderer& renderer, QPainter* painter );
+    bool render( const QRect* dirty, const BoardRenderer& renderer, QPainter* painter ) const;
 
     /**
      * @brief Getters & setters
@@ -36,10 +36,11 @@ void PushView::start( Piece& what, int fromX, int fromY, int toX, int toY )
     mType = what.getType();
     mPieceAngle = what.getAngle();
 
+    // notify before starting since a skipped (turbo) animation stops before animateBetween returns
+    emit stateChanged(QAbstractAnimation::Running, QAbstractAnimation::Stopped);
+
     mHorizontalAnimation.animateBetween( fromX, toX );
     mVerticalAnimation.animateBetween( fromY, toY );
-
-    emit stateChanged(QAbstractAnimation::Running, QAbstractAnimation::Stopped);
 }
 
 void PushView::render( const QRect* rect, QPainter* painter )
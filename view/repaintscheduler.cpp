@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <QRegion>
+
+#include "repaintscheduler.h"
+
+constexpr int RepaintScheduler::DefaultMaxRects;
+constexpr int RepaintScheduler::DefaultFrameInterval;
+
+static int area( const QRect& rect )
+{
+    return rect.width() * rect.height();
+}
+
+RepaintScheduler::RepaintScheduler( QObject* parent ) : QObject(parent), mMaxRects{DefaultMaxRects}, mLastFrameStats{0,0}
+{
+    mFrameTimer.setSingleShot( true );
+    mFrameTimer.setTimerType( Qt::PreciseTimer );
+    mFrameTimer.setInterval( DefaultFrameInterval );
+    QObject::connect( &mFrameTimer, &QTimer::timeout, this, &RepaintScheduler::flush );
+}
+
+void RepaintScheduler::setMaxRects( int maxRects )
+{
+    mMaxRects = std::max( maxRects, 1 );
+}
+
+int RepaintScheduler::getMaxRects() const
+{
+    return mMaxRects;
+}
+
+void RepaintScheduler::setFrameInterval( int msecs )
+{
+    mFrameTimer.setInterval( std::max( msecs, 0 ) );
+}
+
+const std::vector<QRect>& RepaintScheduler::getPending() const
+{
+    return mPending;
+}
+
+const RepaintScheduler::FrameStats& RepaintScheduler::getLastFrameStats() const
+{
+    return mLastFrameStats;
+}
+
+void RepaintScheduler::schedule( const QRect& rect )
+{
+    if ( rect.isEmpty() ) {
+        return;
+    }
+
+    // absorb every pending rect that overlaps, or whose union costs no more than painting the two separately:
+    QRect merged = rect;
+    for( auto it = mPending.begin(); it != mPending.end(); ) {
+        QRect united = merged.united( *it );
+        if ( merged.intersects( *it ) || area( united ) <= area( merged ) + area( *it ) ) {
+            merged = united;
+            mPending.erase( it );
+            // the grown rect may now reach rects already passed over:
+            it = mPending.begin();
+        } else {
+            ++it;
+        }
+    }
+    mPending.push_back( merged );
+
+    if ( static_cast<int>( mPending.size() ) > mMaxRects ) {
+        QRect bounds;
+        for( const QRect& pending : mPending ) {
+            bounds = bounds.united( pending );
+        }
+        mPending.clear();
+        mPending.push_back( bounds );
+    }
+
+    if ( !mFrameTimer.isActive() ) {
+        mFrameTimer.start();
+    }
+}
+
+void RepaintScheduler::flush()
+{
+    mFrameTimer.stop();
+
+    std::vector<QRect> pending;
+    pending.swap( mPending );
+    for( const QRect& rect : pending ) {
+        emit updateRequested( rect );
+    }
+}
+
+void RepaintScheduler::recordPainted( const QRegion& region )
+{
+    mLastFrameStats.rectCount = 0;
+    mLastFrameStats.pixelCount = 0;
+    for( const QRect& rect : region ) {
+        ++mLastFrameStats.rectCount;
+        mLastFrameStats.pixelCount += area( rect );
+    }
+    emit framePainted( mLastFrameStats.rectCount, mLastFrameStats.pixelCount );
+}
@@ -0,0 +1,93 @@
+#ifndef REPAINTSCHEDULER_H
+#define REPAINTSCHEDULER_H
+
+#include <vector>
+#include <QObject>
+#include <QRect>
+#include <QTimer>
+
+QT_FORWARD_DECLARE_CLASS(QRegion)
+
+/**
+ * @brief Collects dirty rectangles over a frame period and requests their repaint once per frame.
+ * Overlapping or neighboring rectangles are merged into a small set of disjoint rectangles. When the set grows past
+ * a configurable cap, it is collapsed into its bounding rectangle.
+ */
+class RepaintScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RepaintScheduler( QObject* parent = nullptr );
+
+    /**
+     * @brief The number of disjoint rectangles that may be pending before collapsing to a bounding rectangle
+     */
+    void setMaxRects( int maxRects );
+    int getMaxRects() const;
+
+    /**
+     * @brief Set the frame period used to pace repaint requests
+     * @param msecs The period in milliseconds
+     */
+    void setFrameInterval( int msecs );
+
+    /**
+     * @brief Get the rectangles pending for the next frame
+     */
+    const std::vector<QRect>& getPending() const;
+
+    /**
+     * @brief Statistics about a painted frame
+     */
+    typedef struct {
+        int rectCount;
+        int pixelCount;
+    } FrameStats;
+
+    /**
+     * @brief Get the statistics of the most recently painted frame
+     */
+    const FrameStats& getLastFrameStats() const;
+
+    /**
+     * @brief Record the area a paint event actually painted
+     * @param region The painted region
+     */
+    void recordPainted( const QRegion& region );
+
+    static constexpr int DefaultMaxRects = 8;
+    static constexpr int DefaultFrameInterval = 16;
+
+public slots:
+    /**
+     * @brief Add a dirty rectangle to be repainted at the next frame
+     */
+    void schedule( const QRect& rect );
+
+    /**
+     * @brief Issue the pending repaint requests now
+     */
+    void flush();
+
+signals:
+    /**
+     * @brief Requests the given area be repainted
+     */
+    void updateRequested( const QRect& rect );
+
+    /**
+     * @brief Notifies the statistics of a painted frame
+     * @param rectCount The number of disjoint rectangles painted
+     * @param pixelCount The total painted area in pixels
+     */
+    void framePainted( int rectCount, int pixelCount );
+
+private:
+    std::vector<QRect> mPending;
+    int mMaxRects;
+    QTimer mFrameTimer;
+    FrameStats mLastFrameStats;
+};
+
+#endif // REPAINTSCHEDULER_H
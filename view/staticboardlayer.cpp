@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <QPainter>
+
+#include "staticboardlayer.h"
+#include "boardrenderer.h"
+
+StaticBoardLayer::StaticBoardLayer( int tileSize ) : mTileSize(tileSize)
+{
+}
+
+void StaticBoardLayer::reset( int width, int height )
+{
+    if ( mPixmap.width() < width || mPixmap.height() < height ) {
+        mPixmap = QPixmap( std::max( width, mPixmap.width() ), std::max( height, mPixmap.height() ) );
+    }
+    mStaleRegion = QRegion( 0, 0, width, height );
+}
+
+void StaticBoardLayer::invalidate( const QRect& rect )
+{
+    mStaleRegion += rect;
+}
+
+void StaticBoardLayer::refresh( Board* board )
+{
+    if ( !mStaleRegion.isEmpty() ) {
+        BoardRenderer renderer( mTileSize );
+        QPainter painter( &mPixmap );
+        for( const QRect& rect : mStaleRegion ) {
+            painter.setClipRect( rect );
+            painter.fillRect( rect, Qt::black );
+            renderer.render( rect, board, &painter );
+        }
+        mStaleRegion = QRegion();
+    }
+}
+
+void StaticBoardLayer::paint( const QRegion& region, QPainter* painter ) const
+{
+    for( const QRect& rect : region ) {
+        painter->drawPixmap( rect, mPixmap, rect );
+    }
+}
+
+const QRegion& StaticBoardLayer::getStaleRegion() const
+{
+    return mStaleRegion;
+}
+
+const QPixmap& StaticBoardLayer::getPixmap() const
+{
+    return mPixmap;
+}
@@ -0,0 +1,60 @@
+#ifndef STATICBOARDLAYER_H
+#define STATICBOARDLAYER_H
+
+#include <QPixmap>
+#include <QRegion>
+
+QT_FORWARD_DECLARE_CLASS(QPainter)
+
+class Board;
+
+/**
+ * @brief A cache of the board's tiles and pieces as last rendered.
+ * Painting copies from the cache; only the areas marked stale are re-rendered from the board beforehand.
+ */
+class StaticBoardLayer
+{
+public:
+    explicit StaticBoardLayer( int tileSize );
+
+    /**
+     * @brief Size the layer for a newly loaded board. The whole board is marked stale.
+     * @param width The board width in pixels
+     * @param height The board height in pixels
+     */
+    void reset( int width, int height );
+
+    /**
+     * @brief Mark an area as stale so it is re-rendered before it is next painted
+     */
+    void invalidate( const QRect& rect );
+
+    /**
+     * @brief Bring the stale areas up to date from the given board
+     */
+    void refresh( Board* board );
+
+    /**
+     * @brief Copy the given area of the layer
+     * @param region The area to copy
+     * @param painter The destination
+     */
+    void paint( const QRegion& region, QPainter* painter ) const;
+
+    /**
+     * @brief Get the area to be re-rendered on the next refresh
+     */
+    const QRegion& getStaleRegion() const;
+
+    /**
+     * @brief Get the cached rendering
+     */
+    const QPixmap& getPixmap() const;
+
+private:
+    int mTileSize;
+    QPixmap mPixmap;
+    QRegion mStaleRegion;
+};
+
+#endif // STATICBOARDLAYER_H
@@ -28,9 +28,9 @@ void TankView::init( GameRegistry* registry )
 void TankView::render( const QRect* rect, QPainter* painter )
 {
     if ( rect->intersects( mBoundingRect ) ) {
-        if ( !(mViewRotation % 360) ) {
+        if ( !(mViewRotation % 90) ) {
             mPreviousPaintRect = mBoundingRect;
-            BoardRenderer::renderPixmap( mBoundingRect, mPixmapType, painter );
+            BoardRenderer::renderRotatedPixmap( ResourcePixmap::getPixmap( mPixmapType ), mBoundingRect, mViewRotation, painter );
         } else {
             QTransform save = painter->transform();
             BoardRenderer::renderRotation( mBoundingRect, mViewRotation, painter );
@@ -73,6 +73,18 @@ void TankView::resume()
     }
 }
 
+int TankView::getMoveDuration( int speed )
+{
+    // a move animates across one square:
+    return mHorizontalAnimation.getDuration( 24, speed );
+}
+
+int TankView::getRotateDuration( int speed )
+{
+    // a turn animates through a quarter rotation:
+    return mRotateAnimation.getDuration( 90, speed );
+}
+
 void TankView::reset( const ModelVector& v )
 {
     stop();
@@ -19,6 +19,16 @@ public:
     void resume();
     void stop();
 
+    /**
+     * @brief The time in milliseconds taken to move one square at the given speed
+     */
+    int getMoveDuration( int speed );
+
+    /**
+     * @brief The time in milliseconds taken to rotate 90 degrees at the given speed
+     */
+    int getRotateDuration( int speed );
+
 signals:
     void changed( const QRect& rect );
 
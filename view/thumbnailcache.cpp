@@ -0,0 +1,190 @@
+#include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QPainter>
+#include <QStandardPaths>
+#include <QTextStream>
+
+#include "thumbnailcache.h"
+#include "boardrenderer.h"
+#include "levelchooser.h"
+#include "controller/gameregistry.h"
+#include "model/board.h"
+#include "util/imageutils.h"
+#include "util/workerthread.h"
+
+constexpr int ThumbnailCache::DefaultCapacity;
+
+/**
+ * @brief The cache as seen by its pending runnables. The cache detaches it when destroyed so late results are dropped.
+ */
+class ThumbnailCacheLink
+{
+public:
+    ThumbnailCacheLink( ThumbnailCache* cache ) : mCache(cache)
+    {
+    }
+
+    bool attached()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        return mCache != nullptr;
+    }
+
+    void detach()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mCache = nullptr;
+    }
+
+    void deliver( int level, const QImage& image )
+    {
+        // held while emitting so the cache cannot be destroyed in between
+        std::lock_guard<std::mutex> guard(mMutex);
+        if ( mCache ) {
+            emit mCache->rasterized( level, image );
+        }
+    }
+
+private:
+    std::mutex mMutex;
+    ThumbnailCache* mCache;
+};
+
+class ThumbnailRunnable : public BasicRunnable
+{
+public:
+    ThumbnailRunnable( std::shared_ptr<ThumbnailCacheLink> link, int level, const QString& cachePath,
+                       std::shared_ptr<TileImageSet> images )
+      : mLink(link), mLevel(level), mCachePath(cachePath), mImages(images)
+    {
+    }
+
+    const char* getName() const override
+    {
+        return "ThumbnailRunnable";
+    }
+
+    void run() override
+    {
+        if ( !mLink->attached() ) {
+            return;
+        }
+
+        QFile mapFile( QString( ":/maps/level%1.txt" ).arg( mLevel ) );
+        if ( !mapFile.open( QIODevice::ReadOnly ) ) {
+            std::cout << "** thumbnail: failed to open " << qPrintable(mapFile.fileName()) << std::endl;
+            return;
+        }
+        QByteArray content = mapFile.readAll();
+
+        QString cacheFile = QDir( mCachePath ).absoluteFilePath( ThumbnailCache::cacheFileName( content, *mImages ) );
+
+        QImage image;
+        if ( !image.load( cacheFile ) ) {
+            Board board;
+            QTextStream stream( &content );
+            board.load( stream, mLevel );
+
+            int tileSize = mImages->tileSize();
+            image = QImage( board.getWidth()*tileSize, board.getHeight()*tileSize, QImage::Format_ARGB32_Premultiplied );
+            image.fill( Qt::transparent );
+            {   QPainter painter( &image );
+                BoardRenderer( tileSize ).render( &board, *mImages, &painter );
+            }
+
+            if ( !image.save( cacheFile ) ) {
+                std::cout << "** thumbnail: failed to save " << qPrintable(cacheFile) << std::endl;
+            }
+        }
+
+        mLink->deliver( mLevel, image );
+    }
+
+    bool deleteWhenDone() override
+    {
+        return true;
+    }
+
+private:
+    std::shared_ptr<ThumbnailCacheLink> mLink;
+    int mLevel;
+    QString mCachePath;
+    std::shared_ptr<TileImageSet> mImages;
+};
+
+ThumbnailCache::ThumbnailCache( int capacity, const char* path ) : QObject(nullptr), mCapacity(std::max( capacity, 1 )),
+  mPath(path ? path : QDir( QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) ).absoluteFilePath("thumbnails")),
+  mLink(std::make_shared<ThumbnailCacheLink>( this ))
+{
+    QObject::connect( this, &ThumbnailCache::rasterized, this, &ThumbnailCache::onRasterized, Qt::QueuedConnection );
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    mLink->detach();
+}
+
+QString ThumbnailCache::getPath() const
+{
+    return mPath;
+}
+
+QString ThumbnailCache::cacheFileName( const QByteArray& mapContent, const TileImageSet& images )
+{
+    QCryptographicHash hash( QCryptographicHash::Sha1 );
+    hash.addData( mapContent );
+    hash.addData( QByteArray::number( images.tileSize() ) );
+    hash.addData( images.version() );
+    return QString( hash.result().toHex() ) + ".png";
+}
+
+const QImage* ThumbnailCache::find( int level ) const
+{
+    auto it = mEntries.find( level );
+    if ( it != mEntries.end() ) {
+        return &it->second.image;
+    }
+    return nullptr;
+}
+
+const QImage* ThumbnailCache::getThumbnail( int level )
+{
+    auto it = mEntries.find( level );
+    if ( it != mEntries.end() ) {
+        mOrder.splice( mOrder.begin(), mOrder, it->second.order );
+        return &it->second.image;
+    }
+
+    if ( !mPending[level] ) {
+        if ( GameRegistry* registry = getRegistry(this) ) {
+            if ( !mImages ) {
+                QDir().mkpath( mPath );
+                mImages = std::make_shared<TileImageSet>( ChooserTileSize );
+            }
+            mPending[level] = true;
+            registry->getWorkerPool().doWork( new ThumbnailRunnable( mLink, level, mPath, mImages ) );
+        }
+    }
+    return nullptr;
+}
+
+void ThumbnailCache::onRasterized( int level, QImage image )
+{
+    mPending.erase( level );
+    if ( image.isNull() || mEntries.find( level ) != mEntries.end() ) {
+        return;
+    }
+
+    while( static_cast<int>( mEntries.size() ) >= mCapacity ) {
+        mEntries.erase( mOrder.back() );
+        mOrder.pop_back();
+    }
+    mOrder.push_front( level );
+    mEntries[level] = { image, mOrder.begin() };
+
+    emit thumbnailReady( level );
+}
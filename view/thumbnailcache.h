@@ -0,0 +1,90 @@
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <map>
+#include <list>
+#include <memory>
+#include <QObject>
+#include <QImage>
+#include <QString>
+
+class TileImageSet;
+class ThumbnailCacheLink;
+
+/**
+ * @brief Level preview images for the level chooser.
+ * Thumbnails are rasterized into QImages on the worker pool and kept in a least-recently-used memory cache. Each is
+ * also persisted to a disk cache keyed by a hash of its map file's content and of the tile artwork, so later runs load
+ * instead of render and changed artwork is re-rendered.
+ */
+class ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity The maximum number of thumbnails held in memory
+     * @param path The disk cache directory. The default is a subdirectory of the user's cache location.
+     */
+    explicit ThumbnailCache( int capacity = DefaultCapacity, const char* path = nullptr );
+    ~ThumbnailCache() override;
+
+    /**
+     * @brief Retrieve the thumbnail for the given level, potentially triggering a background load
+     * @param level The level number
+     * @return The image if present in memory, otherwise nullptr
+     */
+    const QImage* getThumbnail( int level );
+
+    /**
+     * @brief Get the thumbnail if it is already in memory without affecting its recently-used order
+     */
+    const QImage* find( int level ) const;
+
+    /**
+     * @brief Get the disk cache directory
+     */
+    QString getPath() const;
+
+    /**
+     * @brief Get the name of the disk cache file for a map
+     * @param mapContent The content of the map file
+     * @param images The images the thumbnail is rendered with
+     * @return The file name, relative to the disk cache directory
+     */
+    static QString cacheFileName( const QByteArray& mapContent, const TileImageSet& images );
+
+    static constexpr int DefaultCapacity = 64;
+
+signals:
+    /**
+     * @brief Notifies that the thumbnail for the given level is now available
+     * @param level The level number
+     */
+    void thumbnailReady( int level );
+
+    /**
+     * @brief Internal signal for delivering results from the worker pool to the application thread
+     */
+    void rasterized( int level, QImage image );
+
+private slots:
+    void onRasterized( int level, QImage image );
+
+private:
+    typedef struct {
+        QImage image;
+        std::list<int>::iterator order;
+    } Entry;
+
+    int mCapacity;
+    QString mPath;
+    std::map<int,Entry> mEntries;
+    std::list<int> mOrder; // most recently used first
+    std::map<int,bool> mPending;
+    std::shared_ptr<TileImageSet> mImages;
+    std::shared_ptr<ThumbnailCacheLink> mLink;
+};
+
+#endif // THUMBNAILCACHE_H